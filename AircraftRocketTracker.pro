@@ -11,23 +11,63 @@ SOURCES += \
     src/main.cpp \
     src/mainwindow.cpp \
     src/aircraft.cpp \
+    src/aircrafttable.cpp \
+    src/trackhistory.cpp \
+    src/timingwheel.cpp \
+    src/trafficsimulator.cpp \
     src/rocket.cpp \
     src/geoutils.cpp \
+    src/geoutils_avx2.cpp \
+    src/mapprojection.cpp \
+    src/distanceengine.cpp \
+    src/lookangles.cpp \
+    src/spatialindex.cpp \
     src/mapwidget.cpp \
     src/gpsnavigator.cpp \
     src/adsbclient.cpp \
+    src/aircraftfusion.cpp \
+    src/httppoller.cpp \
+    src/feedrecording.cpp \
+    src/feedreplay.cpp \
+    src/modes.cpp \
+    src/cpr.cpp \
+    src/sbsparser.cpp \
+    src/dump1090json.cpp \
     src/rocketclient.cpp \
+    src/trackerdaemon.cpp \
     src/systemgps.cpp
 
 HEADERS += \
     src/mainwindow.h \
     src/aircraft.h \
+    src/aircrafttable.h \
+    src/aircraftdelta.h \
+    src/snapshotstore.h \
+    src/trackhistory.h \
+    src/timingwheel.h \
+    src/trafficsimulator.h \
+    src/monotonicclock.h \
     src/rocket.h \
     src/geoutils.h \
+    src/geobatch.h \
+    src/mapprojection.h \
+    src/distanceengine.h \
+    src/lookangles.h \
+    src/spatialindex.h \
     src/mapwidget.h \
     src/gpsnavigator.h \
     src/adsbclient.h \
+    src/aircraftfusion.h \
+    src/httppoller.h \
+    src/feedrecording.h \
+    src/feedreplay.h \
+    src/beastparser.h \
+    src/modes.h \
+    src/cpr.h \
+    src/sbsparser.h \
+    src/dump1090json.h \
     src/rocketclient.h \
+    src/trackerdaemon.h \
     src/systemgps.h
 
 # Install
@@ -0,0 +1,109 @@
+// AircraftTable vs the QMap<QString, Aircraft> it replaced, in operations per second
+//
+// Build with -DBUILD_BENCHMARKS=ON and run ./bench_aircrafttable
+
+#include "aircrafttable.h"
+#include <QMap>
+#include <QString>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    QString hexKey(uint32_t icao) {
+        return QString("%1").arg(icao, 6, 16, QChar('0'));
+    }
+
+    template<typename Fn>
+    void run(const char* name, int size, size_t ops, int rounds, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        double sink = 0;
+        for (int r = 0; r < rounds; ++r) {
+            sink += fn();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-22s %7d %14.0f ops/s  (check %.0f)\n",
+                    name, size, ops * rounds / seconds, sink);
+    }
+
+    void benchSize(int size) {
+        std::mt19937 rng(size);
+        std::vector<uint32_t> addresses(size);
+        for (uint32_t& a : addresses) a = rng() & 0xFFFFFF;
+
+        // Lookups hit existing entries in random order, as stream messages do
+        std::vector<uint32_t> probes(100000);
+        for (uint32_t& p : probes) p = addresses[rng() % size];
+
+        std::vector<QString> probeKeys;
+        probeKeys.reserve(probes.size());
+        for (uint32_t p : probes) probeKeys.push_back(hexKey(p));
+
+        QMap<QString, Aircraft> map;
+        AircraftTable table;
+        for (uint32_t a : addresses) {
+            map.insert(hexKey(a), Aircraft(a));
+            table.upsert(a);
+        }
+
+        const int rounds = 10;
+
+        run("lookup QMap", size, probes.size(), rounds, [&]() {
+            double sum = 0;
+            for (const QString& key : probeKeys) {
+                auto it = map.constFind(key);
+                if (it != map.constEnd()) sum += it->getAltitude() + 1;
+            }
+            return sum;
+        });
+
+        run("lookup AircraftTable", size, probes.size(), rounds, [&]() {
+            double sum = 0;
+            for (uint32_t p : probes) {
+                const Aircraft* ac = table.find(p);
+                if (ac) sum += ac->getAltitude() + 1;
+            }
+            return sum;
+        });
+
+        // Upsert from a decoded 24-bit address, which is what the stream sources have
+        run("upsert QMap", size, probes.size(), rounds, [&]() {
+            for (uint32_t p : probes) {
+                QString key = hexKey(p);
+                auto it = map.find(key);
+                if (it == map.end()) it = map.insert(key, Aircraft(p));
+                it->setAltitude(it->getAltitude() + 1);
+            }
+            return static_cast<double>(map.size());
+        });
+
+        run("upsert AircraftTable", size, probes.size(), rounds, [&]() {
+            for (uint32_t p : probes) {
+                Aircraft& ac = table.upsert(p);
+                ac.setAltitude(ac.getAltitude() + 1);
+            }
+            return static_cast<double>(table.size());
+        });
+
+        run("iterate QMap", size, size, rounds * 10, [&]() {
+            double sum = 0;
+            for (const Aircraft& ac : map) sum += ac.getAltitude();
+            return sum;
+        });
+
+        run("iterate AircraftTable", size, size, rounds * 10, [&]() {
+            double sum = 0;
+            for (const Aircraft& ac : table) sum += ac.getAltitude();
+            return sum;
+        });
+    }
+}
+
+int main() {
+    std::printf("%-22s %7s %14s\n", "operation", "size", "throughput");
+    for (int size : {1000, 10000, 100000}) {
+        benchSize(size);
+    }
+    return 0;
+}
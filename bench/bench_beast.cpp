@@ -0,0 +1,296 @@
+// Beast framing and the BEAST_TCP source against a local stand-in receiver
+//
+// Build with -DBUILD_BENCHMARKS=ON and run
+//   ./bench_beast
+// A small capture (four DF17 squitters, one Mode A/C reply, escaped 0x1a in a
+// timestamp and a signal byte, a run of junk and a truncated frame) is fed to
+// Beast::Parser in every chunk size, then served by a QTcpServer on 127.0.0.1
+// in random chunks to a raw socket and to an ADSBClient. Each check prints ok
+// or FAIL and the exit status is the number of failures; framing throughput
+// is timed last.
+
+#include "adsbclient.h"
+#include "beastparser.h"
+#include "geoutils.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Expected {
+        char type;
+        uint64_t timestamp;
+        uint8_t signal;
+        QByteArray message;
+    };
+
+    const int EXPECTED_RESYNCS = 2;     // The junk run and the truncated frame
+
+    QByteArray escaped(const QByteArray& body) {
+        QByteArray out;
+        for (char c : body) {
+            out += c;
+            if (static_cast<uint8_t>(c) == Beast::ESCAPE) out += c;
+        }
+        return out;
+    }
+
+    QByteArray encode(const Expected& frame) {
+        QByteArray body;
+        for (int i = 5; i >= 0; --i) {
+            body += static_cast<char>((frame.timestamp >> (8 * i)) & 0xff);
+        }
+        body += static_cast<char>(frame.signal);
+        body += frame.message;
+        return QByteArray(1, static_cast<char>(Beast::ESCAPE)) + frame.type + escaped(body);
+    }
+
+    // Reference squitters from "The 1090 MHz Riddle"
+    const QByteArray IDENT = QByteArray::fromHex("8D4840D6202CC371C32CE0576098");      // KLM1023
+    const QByteArray EVEN = QByteArray::fromHex("8D40621D58C382D690C8AC2863A7");       // 52.2572, 3.9194
+    const QByteArray ODD = QByteArray::fromHex("8D40621D58C386435CC412692AD6");
+    const QByteArray VELOCITY = QByteArray::fromHex("8D485020994409940838175B284F");   // 159 kt, 182.9 deg
+
+    const std::vector<Expected> FRAMES = {
+        {'3', 0x000000001a00, 0x80, IDENT},
+        {'1', 0x000000000002, 0x1a, QByteArray::fromHex("1234")},
+        {'3', 0x000000000003, 0x90, EVEN},
+        {'3', 0x000000000004, 0x91, ODD},
+        {'3', 0x1a1a00000005, 0x92, VELOCITY},
+    };
+
+    QByteArray capture() {
+        QByteArray out;
+        out += encode(FRAMES[0]);
+        out += QByteArray("\x00\xffjunk", 6);
+        out += encode(FRAMES[1]);
+        out += encode(FRAMES[2]);
+        out += QByteArray("\x1a" "3" "\x01\x02\x03\x04", 6);    // Cut short by the next frame
+        out += encode(FRAMES[3]);
+        out += encode(FRAMES[4]);
+        return out;
+    }
+
+    // Receiver side: keeps the unconsumed tail between reads, like ADSBClient
+    struct Framer {
+        Beast::Parser parser;
+        QByteArray buffer;
+        std::vector<Expected> frames;
+
+        void feed(const QByteArray& data) {
+            buffer += data;
+            size_t consumed = parser.parse(reinterpret_cast<const uint8_t*>(buffer.constData()),
+                                           static_cast<size_t>(buffer.size()),
+                                           [this](const Beast::Frame& frame) {
+                frames.push_back({frame.type, frame.timestamp, frame.signal,
+                                  QByteArray(reinterpret_cast<const char*>(frame.data), frame.length)});
+            });
+            buffer.remove(0, static_cast<int>(consumed));
+        }
+
+        bool matches() const {
+            if (frames.size() != FRAMES.size()) return false;
+            for (size_t i = 0; i < frames.size(); ++i) {
+                const Expected& got = frames[i];
+                const Expected& want = FRAMES[i];
+                if (got.type != want.type || got.timestamp != want.timestamp ||
+                    got.signal != want.signal || got.message != want.message) {
+                    return false;
+                }
+            }
+            return parser.framesParsed() == FRAMES.size() &&
+                   parser.resyncs() == static_cast<uint64_t>(EXPECTED_RESYNCS);
+        }
+    };
+
+    // Serves the capture to every connection in random chunks, then closes
+    class StandIn : public QObject {
+    public:
+        StandIn(const QByteArray& data, int maxChunk)
+            : m_data(data), m_maxChunk(maxChunk), m_rng(7)
+        {
+            connect(&m_server, &QTcpServer::newConnection, this, &StandIn::accept);
+            m_server.listen(QHostAddress::LocalHost);
+        }
+
+        quint16 port() const { return m_server.serverPort(); }
+
+    private:
+        QTcpServer m_server;
+        QByteArray m_data;
+        int m_maxChunk;
+        std::mt19937 m_rng;
+
+        void accept() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                // Chunks go out as separate segments, a millisecond apart
+                socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                send(socket, 0);
+            }
+        }
+
+        void send(QPointer<QTcpSocket> socket, int offset) {
+            if (!socket) return;
+            if (offset >= m_data.size()) {
+                socket->disconnectFromHost();
+                return;
+            }
+            int chunk = 1 + static_cast<int>(m_rng() % static_cast<unsigned>(m_maxChunk));
+            socket->write(m_data.mid(offset, chunk));
+            socket->flush();
+            QTimer::singleShot(1, this, [this, socket, offset, chunk]() { send(socket, offset + chunk); });
+        }
+    };
+
+    int g_failures = 0;
+
+    void check(bool ok, const char* what) {
+        std::printf("  %-62s %s\n", what, ok ? "ok" : "FAIL");
+        if (!ok) ++g_failures;
+    }
+
+    // Run the event loop until done() holds; false on timeout
+    bool waitFor(const std::function<bool()>& done, int timeoutMs = 5000) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done()) {
+            if (timer.elapsed() > timeoutMs) return false;
+            QEventLoop loop;
+            QTimer::singleShot(2, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+        return true;
+    }
+
+    void framing() {
+        std::printf("framing in every chunk size\n");
+        const QByteArray data = capture();
+
+        bool whole = false;
+        {
+            Framer framer;
+            framer.feed(data);
+            whole = framer.matches() && framer.buffer.isEmpty();
+        }
+        check(whole, "one read: frames, escapes, framesParsed, resyncs");
+
+        bool fixed = true;
+        for (int chunk = 1; chunk <= data.size(); ++chunk) {
+            Framer framer;
+            for (int offset = 0; offset < data.size(); offset += chunk) {
+                framer.feed(data.mid(offset, chunk));
+            }
+            if (!framer.matches()) {
+                std::printf("    chunk %d: %llu frames, %llu resyncs\n", chunk,
+                            static_cast<unsigned long long>(framer.parser.framesParsed()),
+                            static_cast<unsigned long long>(framer.parser.resyncs()));
+                fixed = false;
+            }
+        }
+        check(fixed, "fixed chunks of 1 byte up to the whole capture");
+
+        bool random = true;
+        std::mt19937 rng(42);
+        for (int round = 0; round < 1000; ++round) {
+            Framer framer;
+            for (int offset = 0; offset < data.size();) {
+                int chunk = 1 + static_cast<int>(rng() % 24);
+                framer.feed(data.mid(offset, chunk));
+                offset += chunk;
+            }
+            if (!framer.matches()) random = false;
+        }
+        check(random, "1000 random splits");
+    }
+
+    void standIn() {
+        std::printf("local stand-in receiver\n");
+        StandIn server(capture(), 9);
+
+        // Raw socket: the framing counters over real reads
+        Framer framer;
+        QTcpSocket socket;
+        QObject::connect(&socket, &QTcpSocket::readyRead, [&]() { framer.feed(socket.readAll()); });
+        socket.connectToHost(QHostAddress::LocalHost, server.port());
+        bool closed = waitFor([&]() { return socket.state() == QAbstractSocket::UnconnectedState && !framer.frames.empty(); });
+        check(closed && framer.matches(), "socket reads: frames, framesParsed, resyncs");
+
+        // The BEAST_TCP source end to end
+        ADSBClient client;
+        client.setSource(ADSBClient::BEAST_TCP);
+        client.setStreamEndpoint("127.0.0.1", server.port());
+        client.setUserLocation(52.0, 4.0);
+        client.start();
+
+        AircraftSnapshot snapshot;
+        bool done = waitFor([&]() {
+            snapshot = client.getAircraft();
+            const Aircraft* positioned = snapshot->find(0x40621d);
+            const Aircraft* moving = snapshot->find(0x485020);
+            return snapshot->contains(0x4840d6) && positioned && positioned->hasPosition() &&
+                   moving && moving->getVelocity() > 0.0;
+        });
+        client.stop();
+        check(done, "three aircraft published within 5 s");
+        if (!done) return;
+
+        const Aircraft* klm = snapshot->find(0x4840d6);
+        const Aircraft* positioned = snapshot->find(0x40621d);
+        const Aircraft* moving = snapshot->find(0x485020);
+        check(snapshot->size() == 3, "exactly three aircraft (Mode A/C ignored)");
+        check(klm && klm->getCallsign() == "KLM1023", "callsign KLM1023");
+        check(positioned && std::fabs(positioned->getLatitude() - 52.2572) < 0.001 &&
+              std::fabs(positioned->getLongitude() - 3.9194) < 0.001, "CPR pair decoded to 52.2572, 3.9194");
+        check(moving && std::fabs(moving->getVelocity() - GeoUtils::knotsToMetersPerSecond(159.2)) < 0.1 &&
+              std::fabs(moving->getHeading() - 182.88) < 0.01, "velocity 159 kt on 182.9 deg");
+    }
+
+    void throughput() {
+        std::printf("framing throughput\n");
+        const QByteArray one = capture();
+        QByteArray data;
+        while (data.size() < 16 * 1024 * 1024) data += one;
+
+        Beast::Parser parser;
+        uint64_t sum = 0;
+        QElapsedTimer timer;
+        timer.start();
+        // 64 KiB reads, as a busy receiver delivers them
+        size_t pos = 0;
+        const size_t size = static_cast<size_t>(data.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.constData());
+        while (pos < size) {
+            size_t end = std::min(size, pos + 65536);
+            pos += parser.parse(bytes + pos, end - pos, [&](const Beast::Frame& frame) {
+                sum += frame.data[0];
+            });
+            if (end == size) break;
+        }
+        double seconds = timer.nsecsElapsed() / 1e9;
+        std::printf("    %.1f MB/s, %.2f M frames/s (checksum %llu)\n",
+                    data.size() / seconds / 1e6, parser.framesParsed() / seconds / 1e6,
+                    static_cast<unsigned long long>(sum));
+    }
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    framing();
+    standIn();
+    throughput();
+
+    std::printf("%s: %d failure(s)\n", g_failures == 0 ? "PASS" : "FAIL", g_failures);
+    return g_failures;
+}
@@ -0,0 +1,107 @@
+// aircraft.json parsing: QJsonDocument DOM vs the Dump1090Json pull parser
+//
+// Build with -DBUILD_BENCHMARKS=ON and run
+//   ./bench_dump1090json [aircraft.json ...]
+// Without arguments a readsb-style document with 1000 aircraft is synthesized.
+
+#include "dump1090json.h"
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+    QByteArray synthesize(int count) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        QByteArray json = "{ \"now\" : 1700000000.0,\n  \"messages\" : 123456789,\n  \"aircraft\" : [\n";
+        for (int i = 0; i < count; ++i) {
+            char entry[1024];
+            std::snprintf(entry, sizeof(entry),
+                "    {\"hex\":\"%06x\",\"type\":\"adsb_icao\",\"flight\":\"TST%04d \","
+                "\"alt_baro\":%d,\"alt_geom\":%d,\"gs\":%.1f,\"track\":%.2f,\"baro_rate\":%d,"
+                "\"squawk\":\"%04d\",\"emergency\":\"none\",\"category\":\"A3\","
+                "\"nav_qnh\":1013.2,\"nav_altitude_mcp\":36000,\"nav_modes\":[\"autopilot\",\"tcas\"],"
+                "\"lat\":%.6f,\"lon\":%.6f,\"nic\":8,\"rc\":186,\"seen_pos\":%.1f,\"version\":2,"
+                "\"nic_baro\":1,\"nac_p\":9,\"nac_v\":1,\"sil\":3,\"sil_type\":\"perhour\","
+                "\"gva\":2,\"sda\":2,\"mlat\":[],\"tisb\":[],\"messages\":%d,\"seen\":%.1f,\"rssi\":%.1f}%s\n",
+                0x400000 + i, i, 1000 + (i * 37) % 40000, 1100 + (i * 37) % 40000,
+                150.0 + unit(rng) * 350.0, unit(rng) * 360.0, (i % 41 - 20) * 64, 1000 + i % 7000,
+                30.0 + unit(rng) * 30.0, -120.0 + unit(rng) * 40.0, unit(rng) * 10.0,
+                i * 13, unit(rng) * 20.0, -30.0 + unit(rng) * 20.0,
+                i + 1 < count ? "," : "");
+            json += entry;
+        }
+        json += "  ]\n}\n";
+        return json;
+    }
+
+    // The fields the tracker reads, summed so neither path can be optimized away
+    double parseDom(const QByteArray& data) {
+        double sum = 0;
+        QJsonDocument doc = QJsonDocument::fromJson(data);
+        QJsonArray aircraft = doc.object()["aircraft"].toArray();
+        for (const QJsonValue& value : aircraft) {
+            QJsonObject obj = value.toObject();
+            sum += obj["hex"].toString().size();
+            sum += obj["flight"].toString().trimmed().size();
+            sum += obj["lat"].toDouble() + obj["lon"].toDouble();
+            sum += obj["alt_baro"].toDouble() + obj["gs"].toDouble() + obj["track"].toDouble();
+            sum += obj["baro_rate"].toDouble() + obj["squawk"].toString().toInt();
+            sum += obj["seen"].toDouble();
+        }
+        return sum;
+    }
+
+    double parsePull(const QByteArray& data) {
+        double sum = 0;
+        Dump1090Json::Reader reader(data.constData(), static_cast<size_t>(data.size()));
+        Dump1090Json::Entry e;
+        while (reader.next(e)) {
+            sum += e.icao + e.lat + e.lon + e.altitudeFt + e.groundSpeedKt + e.trackDeg;
+            sum += e.verticalRateFpm + e.squawk + e.seen;
+        }
+        return sum;
+    }
+
+    template<typename Fn>
+    void run(const char* name, const QByteArray& data, int rounds, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        double sink = 0;
+        for (int r = 0; r < rounds; ++r) {
+            sink += fn(data);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-16s %10.1f docs/s %8.1f MB/s  (check %.0f)\n",
+                    name, rounds / seconds, data.size() * rounds / seconds / 1e6, sink);
+    }
+
+    void benchDocument(const char* label, const QByteArray& data) {
+        std::printf("%s: %lld bytes\n", label, static_cast<long long>(data.size()));
+        const int rounds = 50;
+        run("QJsonDocument", data, rounds, parseDom);
+        run("Dump1090Json", data, rounds, parsePull);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        benchDocument("synthetic 1000 aircraft", synthesize(1000));
+        return 0;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        QFile file(argv[i]);
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        benchDocument(argv[i], file.readAll());
+    }
+    return 0;
+}
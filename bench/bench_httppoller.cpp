@@ -0,0 +1,391 @@
+// HttpPoller against a local HTTP stand-in: conditional requests, repeated
+// bodies, compression, in-flight dedup, Retry-After and error backoff
+//
+// Build with -DBUILD_BENCHMARKS=ON and run
+//   ./bench_httppoller
+// A QTcpServer on 127.0.0.1 answers every request from a scripted handler and
+// records what the poller sent. Each check prints ok or FAIL and the exit
+// status is the number of failures; the cost of a conditional poll that ends
+// in a 304 is timed last.
+
+#include "httppoller.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace {
+    using Headers = QList<QPair<QByteArray, QByteArray>>;
+
+    struct Request {
+        qint64 timeMs = 0;      // Since the stand-in started listening
+        Headers headers;        // Names lower-cased
+
+        QByteArray header(const QByteArray& name) const {
+            for (const auto& header : headers) {
+                if (header.first == name) return header.second;
+            }
+            return QByteArray();
+        }
+    };
+
+    struct Response {
+        int status = 200;
+        QByteArray reason = "OK";
+        Headers headers;
+        QByteArray body;
+        int delayMs = 0;        // Held back this long before answering
+    };
+
+    // Minimal HTTP/1.1 server: one request per connection, then close
+    class StandIn : public QObject {
+    public:
+        std::function<Response(const Request&)> handler;
+        std::vector<Request> requests;
+
+        StandIn() {
+            connect(&m_server, &QTcpServer::newConnection, this, &StandIn::accept);
+            m_server.listen(QHostAddress::LocalHost);
+            m_clock.start();
+        }
+
+        QUrl url() const {
+            return QUrl(QString("http://127.0.0.1:%1/data/aircraft.json").arg(m_server.serverPort()));
+        }
+
+    private:
+        QTcpServer m_server;
+        QElapsedTimer m_clock;
+
+        void accept() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { read(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        }
+
+        void read(QTcpSocket* socket) {
+            QByteArray buffer = socket->property("request").toByteArray() + socket->readAll();
+            int end = buffer.indexOf("\r\n\r\n");
+            if (end < 0) {
+                socket->setProperty("request", buffer);
+                return;
+            }
+
+            Request request;
+            request.timeMs = m_clock.elapsed();
+            const QList<QByteArray> lines = buffer.left(end).split('\n');
+            for (int i = 1; i < lines.size(); ++i) {
+                int colon = lines[i].indexOf(':');
+                if (colon <= 0) continue;
+                request.headers.append({lines[i].left(colon).trimmed().toLower(),
+                                        lines[i].mid(colon + 1).trimmed()});
+            }
+            requests.push_back(request);
+
+            Response response = handler(request);
+            QPointer<QTcpSocket> guard(socket);
+            QTimer::singleShot(response.delayMs, this, [guard, response]() {
+                if (guard) write(guard, response);
+            });
+        }
+
+        static void write(QTcpSocket* socket, const Response& response) {
+            QByteArray out = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + response.reason + "\r\n";
+            for (const auto& header : response.headers) {
+                out += header.first + ": " + header.second + "\r\n";
+            }
+            // A 304 carries no body
+            if (response.status != 304) {
+                out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+            }
+            out += "Connection: close\r\n\r\n";
+            if (response.status != 304) out += response.body;
+
+            socket->write(out);
+            socket->disconnectFromHost();
+        }
+    };
+
+    // Signals of one poller, counted
+    struct Observed {
+        int data = 0;
+        int notModified = 0;
+        int failed = 0;
+        QByteArray lastBody;
+
+        explicit Observed(HttpPoller& poller) {
+            QObject::connect(&poller, &HttpPoller::dataReceived, [this](const QByteArray& body) {
+                ++data;
+                lastBody = body;
+            });
+            QObject::connect(&poller, &HttpPoller::notModified, [this]() { ++notModified; });
+            QObject::connect(&poller, &HttpPoller::failed, [this](const QString&) { ++failed; });
+        }
+    };
+
+    int g_failures = 0;
+
+    void check(bool ok, const char* what) {
+        std::printf("  %-62s %s\n", what, ok ? "ok" : "FAIL");
+        if (!ok) ++g_failures;
+    }
+
+    // Run the event loop until done() holds; false on timeout
+    bool waitFor(const std::function<bool()>& done, int timeoutMs = 5000) {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done()) {
+            if (timer.elapsed() > timeoutMs) return false;
+            QEventLoop loop;
+            QTimer::singleShot(2, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+        return true;
+    }
+
+    qint64 gap(const StandIn& server, size_t index) {
+        return server.requests[index].timeMs - server.requests[index - 1].timeMs;
+    }
+
+    const QByteArray ETAG = "\"3f2a-61b1\"";
+    const QByteArray LAST_MODIFIED = "Tue, 01 Oct 2024 10:00:00 GMT";
+    const QByteArray BODY_A = "{\"now\":1700000000.0,\"aircraft\":[{\"hex\":\"4ca1fa\",\"lat\":53.4,\"lon\":-6.2}]}";
+    const QByteArray BODY_B = "{\"now\":1700000001.0,\"aircraft\":[{\"hex\":\"4ca1fa\",\"lat\":53.5,\"lon\":-6.2}]}";
+
+    void conditionalRequests(QNetworkAccessManager& manager) {
+        std::printf("conditional requests\n");
+        StandIn server;
+        server.handler = [&](const Request& request) {
+            Response response;
+            if (request.header("if-none-match") == ETAG) {
+                response.status = 304;
+                response.reason = "Not Modified";
+            } else {
+                response.body = BODY_A;
+            }
+            response.headers = {{"ETag", ETAG}, {"Last-Modified", LAST_MODIFIED}};
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(20, 160);
+        poller.start();
+        bool done = waitFor([&]() { return observed.notModified >= 3; });
+        poller.stop();
+
+        check(done, "three 304s within 5 s");
+        if (!done) return;
+        check(observed.data == 1 && observed.lastBody == BODY_A, "first response delivered once");
+        check(server.requests[0].header("if-none-match").isEmpty(), "first request unconditional");
+        check(server.requests[1].header("if-none-match") == ETAG, "ETag echoed as If-None-Match");
+        check(server.requests[1].header("if-modified-since") == LAST_MODIFIED,
+              "Last-Modified echoed as If-Modified-Since");
+        check(server.requests[0].header("accept-encoding").contains("gzip"),
+              "compression negotiated by the network stack");
+        check(poller.stats().notModified == 3 && poller.stats().modified == 1, "stats count 304s apart");
+        check(poller.currentInterval() == 20 * 3 / 2 * 3 / 2 * 3 / 2, "each 304 stretches the interval");
+        check(gap(server, 3) > gap(server, 1), "polls spread out while nothing changes");
+    }
+
+    void repeatedBodies(QNetworkAccessManager& manager) {
+        std::printf("repeated bodies, no validators\n");
+        StandIn server;
+        server.handler = [&](const Request&) {
+            Response response;
+            // The same document three times, deflated, then an update
+            if (server.requests.size() <= 3) {
+                response.body = qCompress(BODY_A).mid(4);     // zlib stream without Qt's length prefix
+                response.headers = {{"Content-Encoding", "deflate"}};
+            } else {
+                response.body = BODY_B;
+            }
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(20, 160);
+        poller.start();
+
+        bool repeated = waitFor([&]() { return observed.notModified >= 2; });
+        int stretched = poller.currentInterval();
+        check(repeated, "two repeats within 5 s");
+        check(observed.data == 1 && observed.lastBody == BODY_A, "deflated body inflated before delivery");
+        check(poller.stats().unchanged == 2 && poller.stats().notModified == 0,
+              "identical bodies counted as unchanged");
+        check(stretched > 20, "unchanged bodies stretch the interval");
+
+        bool updated = waitFor([&]() { return observed.data >= 2; });
+        poller.stop();
+        check(updated && observed.lastBody == BODY_B, "changed body delivered");
+        check(poller.currentInterval() == std::max(stretched / 2, 20), "a change halves the interval");
+    }
+
+    void inFlightDedup(QNetworkAccessManager& manager) {
+        std::printf("one request in flight\n");
+        const int serverDelayMs = 300;
+        const int intervalMs = 100;
+        StandIn server;
+        server.handler = [&](const Request&) {
+            Response response;
+            response.body = BODY_A + QByteArray::number(static_cast<int>(server.requests.size()));
+            response.delayMs = serverDelayMs;
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(intervalMs, intervalMs);
+        poller.start();
+
+        bool received = waitFor([&]() { return server.requests.size() == 1; });
+        poller.pollNow();
+        poller.pollNow();
+        check(received && poller.isInFlight(), "request in flight");
+        check(poller.stats().skipped == 2 && poller.stats().requests == 1, "pollNow() during a request dropped");
+
+        bool next = waitFor([&]() { return server.requests.size() >= 2; });
+        poller.stop();
+        check(next && observed.data >= 1, "reply delivered, next poll sent");
+        if (next) {
+            check(gap(server, 1) >= serverDelayMs + intervalMs - 10,
+                  "next poll scheduled from the end of the reply");
+        }
+    }
+
+    void retryAfter(QNetworkAccessManager& manager) {
+        std::printf("Retry-After\n");
+        StandIn server;
+        server.handler = [&](const Request&) {
+            Response response;
+            if (server.requests.size() == 1) {
+                response.status = 503;
+                response.reason = "Service Unavailable";
+                response.headers = {{"Retry-After", "1"}};
+            } else {
+                response.body = BODY_A;
+            }
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(20, 160);
+        poller.start();
+        bool done = waitFor([&]() { return observed.data >= 1; });
+        poller.stop();
+
+        check(done, "recovered within 5 s");
+        if (!done) return;
+        check(observed.failed == 1 && poller.stats().errors == 1, "503 reported as failure");
+        std::printf("    retry after %lld ms\n", static_cast<long long>(gap(server, 1)));
+        check(gap(server, 1) >= 990, "Retry-After: 1 beats the 40 ms backoff");
+    }
+
+    void backoff(QNetworkAccessManager& manager) {
+        std::printf("error backoff\n");
+        const int failures = 6;
+        StandIn server;
+        server.handler = [&](const Request&) {
+            Response response;
+            if (server.requests.size() <= failures) {
+                response.status = 500;
+                response.reason = "Internal Server Error";
+            } else {
+                response.body = BODY_A + QByteArray::number(static_cast<int>(server.requests.size()));
+            }
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(20, 320);
+        poller.start();
+        bool done = waitFor([&]() { return observed.data >= 2; });
+        poller.stop();
+
+        check(done, "recovered within 5 s");
+        if (!done) return;
+        check(observed.failed == failures, "every 500 reported");
+
+        // 40, 80, 160, 320, 320 ms after failures 1..5, then 320 after the sixth
+        bool doubling = true;
+        std::printf("    gaps");
+        for (int i = 1; i <= failures; ++i) {
+            qint64 expected = std::min(20 << i, 320);
+            qint64 actual = gap(server, static_cast<size_t>(i));
+            std::printf(" %lld", static_cast<long long>(actual));
+            if (actual < expected - 5 || actual > expected + 150) doubling = false;
+        }
+        std::printf(" ms\n");
+        check(doubling, "gaps double from twice the minimum up to the maximum");
+        check(gap(server, failures + 1) < 150, "a good response resets the backoff");
+    }
+
+    void timeNotModified(QNetworkAccessManager& manager) {
+        std::printf("conditional poll round trip\n");
+        StandIn server;
+        server.handler = [&](const Request& request) {
+            Response response;
+            if (request.header("if-none-match") == ETAG) {
+                response.status = 304;
+                response.reason = "Not Modified";
+            } else {
+                response.body = BODY_A;
+            }
+            response.headers = {{"ETag", ETAG}};
+            return response;
+        };
+
+        HttpPoller poller(&manager);
+        Observed observed(poller);
+        poller.setRequest(QNetworkRequest(server.url()));
+        poller.setInterval(60000);
+        poller.start();
+        waitFor([&]() { return observed.data == 1; });
+
+        const int rounds = 200;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < rounds; ++i) {
+            int before = observed.notModified;
+            poller.pollNow();
+            if (!waitFor([&]() { return observed.notModified > before; })) break;
+        }
+        qint64 elapsedNs = timer.nsecsElapsed();
+        poller.stop();
+
+        check(observed.notModified == rounds, "every conditional poll answered with 304");
+        std::printf("    %.1f us per 304 poll over %d polls\n", elapsedNs / 1000.0 / rounds, rounds);
+    }
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QNetworkAccessManager manager;
+
+    conditionalRequests(manager);
+    repeatedBodies(manager);
+    inFlightDedup(manager);
+    retryAfter(manager);
+    backoff(manager);
+    timeNotModified(manager);
+
+    std::printf("%s: %d failure(s)\n", g_failures == 0 ? "PASS" : "FAIL", g_failures);
+    return g_failures;
+}
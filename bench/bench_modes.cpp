@@ -0,0 +1,147 @@
+// Mode S decoder and CPR throughput, in frames per second
+//
+// Build with -DBUILD_BENCHMARKS=ON and run ./bench_modes [frames]
+
+#include "modes.h"
+#include "cpr.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+    // Bit-at-a-time reference, i.e. what the table replaces
+    uint32_t crc24Bitwise(const uint8_t* msg, int bits) {
+        uint32_t crc = 0;
+        for (int i = 0; i < (bits - 24) / 8; ++i) {
+            crc ^= static_cast<uint32_t>(msg[i]) << 16;
+            for (int b = 0; b < 8; ++b) {
+                crc <<= 1;
+                if (crc & 0x1000000) crc ^= 0xFFF409;
+            }
+        }
+        return crc & 0xFFFFFF;
+    }
+
+    std::vector<uint8_t> fromHex(const char* hex) {
+        std::vector<uint8_t> out;
+        for (; hex[0] && hex[1]; hex += 2) {
+            out.push_back(static_cast<uint8_t>(std::strtoul(std::string(hex, 2).c_str(), nullptr, 16)));
+        }
+        return out;
+    }
+
+    // A mix of identification, airborne position, surface position and velocity
+    std::vector<std::vector<uint8_t>> makeFrames(size_t count) {
+        const char* samples[] = {
+            "8D4840D6202CC371C32CE0576098",
+            "8D40621D58C382D690C8AC2863A7",
+            "8D40621D58C386435CC412692AD6",
+            "8D485020994409940838175B284F",
+            "8C4841753A9A153237AEF0F275BE"
+        };
+
+        std::vector<std::vector<uint8_t>> frames;
+        frames.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<uint8_t> f = fromHex(samples[i % 5]);
+            f[1] = static_cast<uint8_t>(i >> 16);
+            f[2] = static_cast<uint8_t>(i >> 8);
+            f[3] = static_cast<uint8_t>(i);
+            uint32_t crc = ModeS::crc24(f.data(), 112);
+            f[11] = static_cast<uint8_t>(crc >> 16);
+            f[12] = static_cast<uint8_t>(crc >> 8);
+            f[13] = static_cast<uint8_t>(crc);
+            frames.push_back(f);
+        }
+        return frames;
+    }
+
+    template<typename Fn>
+    void run(const char* name, size_t frames, int rounds, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        size_t sink = 0;
+        for (int r = 0; r < rounds; ++r) {
+            sink += fn();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-24s %12.0f frames/s  (check %zu)\n",
+                    name, frames * rounds / seconds, sink);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const int rounds = 20;
+
+    std::vector<std::vector<uint8_t>> frames = makeFrames(count);
+
+    std::string avr;
+    for (const auto& f : frames) {
+        avr += '*';
+        for (uint8_t b : f) {
+            char hex[3];
+            std::snprintf(hex, sizeof(hex), "%02X", b);
+            avr += hex;
+        }
+        avr += ";\n";
+    }
+
+    run("crc24 (bitwise)", count, rounds, [&]() {
+        size_t ok = 0;
+        for (const auto& f : frames) ok += crc24Bitwise(f.data(), 112) != 0;
+        return ok;
+    });
+
+    run("crc24 (table)", count, rounds, [&]() {
+        size_t ok = 0;
+        for (const auto& f : frames) ok += ModeS::crc24(f.data(), 112) != 0;
+        return ok;
+    });
+
+    run("decode", count, rounds, [&]() {
+        size_t ok = 0;
+        ModeS::Message msg;
+        for (const auto& f : frames) ok += ModeS::decode(f.data(), 14, msg);
+        return ok;
+    });
+
+    run("AVR parse + decode", count, rounds, [&]() {
+        size_t ok = 0;
+        ModeS::Message msg;
+        ModeS::parseAvrStream(avr.data(), avr.size(), [&](const uint8_t* frame, int length) {
+            ok += ModeS::decode(frame, length, msg);
+        });
+        return ok;
+    });
+
+    // Position decode on the even/odd pair from the sample set
+    ModeS::Message even, odd;
+    ModeS::decode(frames[1].data(), 14, even);
+    ModeS::decode(frames[2].data(), 14, odd);
+
+    run("CPR global", count, rounds, [&]() {
+        size_t ok = 0;
+        CPR::FrameState state;
+        double lat, lon;
+        for (size_t i = 0; i < count; ++i) {
+            state.record(false, even.cprLat, even.cprLon, false, 1 + (i & 1));
+            state.record(true, odd.cprLat, odd.cprLon, false, 2 - (i & 1));
+            ok += CPR::decodeGlobal(state, 0.0, 0.0, lat, lon);
+        }
+        return ok;
+    });
+
+    run("CPR local", count, rounds, [&]() {
+        size_t ok = 0;
+        double lat, lon;
+        for (size_t i = 0; i < count; ++i) {
+            ok += CPR::decodeLocal(even.cprLat, even.cprLon, false, false,
+                                   52.0 + (i & 7) * 0.01, 3.9, lat, lon);
+        }
+        return ok;
+    });
+
+    return 0;
+}
@@ -0,0 +1,802 @@
+// Tracker hot paths: geodesy, feed parsing, map painting and the aircraft list
+//
+// Build with -DBUILD_BENCHMARKS=ON and run
+//   ./tracker_bench [--json results.json] [--filter text] [--quick] [recording.rec ...]
+//
+// Every input is synthesized from fixed seeds, so two builds measure the same
+// work. Each benchmark is calibrated to run for at least 50 ms per sample and
+// sampled 7 times; the JSON report carries every sample, so runs from
+// different commits can be compared offline. Recordings made with --record
+// are parsed payload by payload through the client they came from.
+
+#include "adsbclient.h"
+#include "rocketclient.h"
+#include "mapwidget.h"
+#include "mainwindow.h"
+#include "geoutils.h"
+#include "distanceengine.h"
+#include "lookangles.h"
+#include "mapprojection.h"
+#include "spatialindex.h"
+#include "trafficsimulator.h"
+#include "feedrecording.h"
+#include "monotonicclock.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    // Los Angeles, MainWindow's default location
+    constexpr double HOME_LAT = 34.0522;
+    constexpr double HOME_LON = -118.2437;
+    constexpr double AREA_RADIUS = 60000.0;     // Mostly on screen at the default map scale
+
+    struct Settings {
+        int samples = 7;
+        int64_t minSampleNs = 50 * MonotonicClock::NS_PER_MS;
+        QString filter;
+    };
+
+    struct Result {
+        QString name;
+        long long items;                // Aircraft, launches or points per operation
+        long long operations;           // Operations timed per sample
+        std::vector<double> samplesNs;  // Per operation
+    };
+
+    Settings g_settings;
+    std::vector<Result> g_results;
+    QJsonArray g_accuracy;              // Rows of the DistanceEngine error tables
+    volatile double g_sink = 0.0;       // Keeps results alive past the optimizer
+
+    bool selected(const QString& name) {
+        return g_settings.filter.isEmpty() || name.contains(g_settings.filter);
+    }
+
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+    }
+
+    void report(const QString& name, long long items, long long operations, std::vector<double> samplesNs) {
+        double med = median(samplesNs);
+        std::fprintf(stderr, "%-34s %8lld items %14.1f ns/op %10.1f ns/item\n",
+                     qPrintable(name), items, med, items > 0 ? med / items : med);
+        g_results.push_back({name, items, operations, std::move(samplesNs)});
+    }
+
+    template<typename Fn>
+    int64_t timeOps(long long operations, Fn& fn) {
+        int64_t start = MonotonicClock::nowNs();
+        double sink = 0.0;
+        for (long long i = 0; i < operations; ++i) {
+            sink += fn();
+        }
+        int64_t elapsed = MonotonicClock::nowNs() - start;
+        g_sink = g_sink + sink;
+        return elapsed;
+    }
+
+    // fn() performs one operation and returns something derived from its result
+    template<typename Fn>
+    void measure(const QString& name, long long items, Fn fn) {
+        if (!selected(name)) return;
+
+        g_sink = g_sink + fn();     // Warm-up: caches, first-touch allocations
+
+        long long operations = 1;
+        for (;;) {
+            int64_t elapsed = timeOps(operations, fn);
+            if (elapsed >= g_settings.minSampleNs || operations >= (1LL << 30)) break;
+            operations *= elapsed * 10 < g_settings.minSampleNs ? 10 : 2;
+        }
+
+        std::vector<double> samples;
+        for (int s = 0; s < g_settings.samples; ++s) {
+            samples.push_back(static_cast<double>(timeOps(operations, fn)) / operations);
+        }
+        report(name, items, operations, std::move(samples));
+    }
+
+    // Deterministic xorshift, so inputs do not depend on the standard library
+    struct Rng {
+        uint64_t state;
+        explicit Rng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+        double uniform() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+        }
+        double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+    };
+
+    TrafficSimulator traffic(int count, uint64_t seed) {
+        TrafficSimulator::Config config;
+        config.seed = seed;
+        config.aircraft = count;
+        TrafficSimulator sim(config);
+        sim.reset(HOME_LAT, HOME_LON, AREA_RADIUS);
+        return sim;
+    }
+
+    void applyTarget(Aircraft& ac, const TrafficSimulator::Target& t, int64_t nowNs) {
+        if (ac.getCallsign().isEmpty()) ac.setCallsign(QString::fromLatin1(t.callsign));
+        ac.setPosition(t.lat, t.lon, nowNs);
+        ac.setAltitude(t.altitude);
+        ac.setVelocity(t.speed);
+        ac.setHeading(t.heading);
+        ac.setVerticalRate(t.verticalRate);
+        ac.setLastSeen(nowNs);
+    }
+
+    // ---- Inputs ----------------------------------------------------------
+
+    QByteArray dump1090Document(const TrafficSimulator& sim) {
+        std::string json = "{ \"now\" : 1700000000.0,\n  \"messages\" : 123456789,\n  \"aircraft\" : [\n";
+        char entry[1024];
+        for (size_t i = 0; i < sim.size(); ++i) {
+            const TrafficSimulator::Target& t = sim.targets()[i];
+            std::snprintf(entry, sizeof(entry),
+                "    {\"hex\":\"%06x\",\"type\":\"adsb_icao\",\"flight\":\"%-8s\","
+                "\"alt_baro\":%d,\"alt_geom\":%d,\"gs\":%.1f,\"track\":%.2f,\"baro_rate\":%d,"
+                "\"squawk\":\"%04d\",\"emergency\":\"none\",\"category\":\"A3\","
+                "\"lat\":%.6f,\"lon\":%.6f,\"nic\":8,\"rc\":186,\"seen_pos\":0.4,\"version\":2,"
+                "\"mlat\":[],\"tisb\":[],\"messages\":%zu,\"seen\":0.2,\"rssi\":-21.5}%s\n",
+                t.icao, t.callsign,
+                static_cast<int>(GeoUtils::metersToFeet(t.altitude)),
+                static_cast<int>(GeoUtils::metersToFeet(t.altitude)) + 100,
+                GeoUtils::metersPerSecondToKnots(t.speed), t.heading,
+                static_cast<int>(GeoUtils::metersToFeet(t.verticalRate) * 60.0),
+                static_cast<int>(1000 + i % 6000), t.lat, t.lon, 100 + i * 7,
+                i + 1 < sim.size() ? "," : "");
+            json += entry;
+        }
+        json += "  ]\n}\n";
+        return QByteArray(json.data(), static_cast<int>(json.size()));
+    }
+
+    QByteArray openSkyDocument(const TrafficSimulator& sim) {
+        std::string json = "{\"time\":1700000000,\"states\":[";
+        char entry[512];
+        for (size_t i = 0; i < sim.size(); ++i) {
+            const TrafficSimulator::Target& t = sim.targets()[i];
+            std::snprintf(entry, sizeof(entry),
+                "[\"%06x\",\"%-8s\",\"United States\",1699999999,1699999999,%.4f,%.4f,%.2f,false,"
+                "%.2f,%.2f,%.2f,null,%.2f,\"%04d\",false,0]%s",
+                t.icao, t.callsign, t.lon, t.lat, t.altitude, t.speed, t.heading,
+                t.verticalRate, t.altitude + 30.0, static_cast<int>(1000 + i % 6000),
+                i + 1 < sim.size() ? "," : "");
+            json += entry;
+        }
+        json += "]}";
+        return QByteArray(json.data(), static_cast<int>(json.size()));
+    }
+
+    QByteArray launchLibraryDocument(int count, uint64_t seed) {
+        Rng rng(seed);
+        std::string json = "{\"count\":" + std::to_string(count) + ",\"next\":null,\"results\":[";
+        char entry[1024];
+        for (int i = 0; i < count; ++i) {
+            std::snprintf(entry, sizeof(entry),
+                "{\"id\":\"%08x-0000-4000-8000-%012d\",\"name\":\"Falcon 9 Block 5 | Mission %d\","
+                "\"status\":{\"id\":1,\"name\":\"Go for Launch\",\"abbrev\":\"Go\"},"
+                "\"net\":\"2030-%02d-%02dT%02d:%02d:00Z\","
+                "\"launch_service_provider\":{\"id\":121,\"name\":\"SpaceX\",\"type\":\"Commercial\"},"
+                "\"mission\":{\"id\":%d,\"name\":\"Mission %d\",\"description\":\"Payload delivery to orbit.\","
+                "\"type\":\"Communications\",\"orbit\":{\"id\":8,\"name\":\"Low Earth Orbit\"}},"
+                "\"pad\":{\"id\":80,\"name\":\"Space Launch Complex 40\",\"latitude\":\"28.56\","
+                "\"longitude\":\"-80.57\",\"location\":{\"id\":12,\"name\":\"Cape Canaveral, FL, USA\","
+                "\"latitude\":%.4f,\"longitude\":%.4f}}}%s",
+                static_cast<unsigned>(seed * 2654435761u + i), i, i,
+                1 + i % 12, 1 + i % 28, i % 24, i % 60, i, i,
+                rng.uniform(-60.0, 60.0), rng.uniform(-180.0, 180.0),
+                i + 1 < count ? "," : "");
+            json += entry;
+        }
+        json += "]}";
+        return QByteArray(json.data(), static_cast<int>(json.size()));
+    }
+
+    // ---- Benchmarks ------------------------------------------------------
+
+    void benchGeo() {
+        constexpr int POINTS = 4096;
+        Rng rng(1);
+        std::vector<double> coords(POINTS * 4);
+        for (double& c : coords) c = rng.uniform(-80.0, 80.0);
+
+        size_t next = 0;
+        measure("geo/calculateDistance", 1, [&]() {
+            const double* p = &coords[(next++ % POINTS) * 4];
+            return GeoUtils::calculateDistance(p[0], p[1], p[2], p[3]);
+        });
+        measure("geo/calculateBearing", 1, [&]() {
+            const double* p = &coords[(next++ % POINTS) * 4];
+            return GeoUtils::calculateBearing(p[0], p[1], p[2], p[3]);
+        });
+    }
+
+    // Range and bearing of a whole fleet from the user: scalar calls against the batch kernels
+    void benchGeoFleet(int count) {
+        Rng rng(6);
+        std::vector<double> lats(count), lons(count), distances(count), bearings(count);
+        for (int i = 0; i < count; ++i) {
+            lats[i] = HOME_LAT + rng.uniform(-3.0, 3.0);
+            lons[i] = HOME_LON + rng.uniform(-3.0, 3.0);
+        }
+
+        measure(QString("geo/fleet/%1/calls").arg(count), count, [&]() {
+            for (int i = 0; i < count; ++i) {
+                distances[i] = GeoUtils::calculateDistance(HOME_LAT, HOME_LON, lats[i], lons[i]);
+                bearings[i] = GeoUtils::calculateBearing(HOME_LAT, HOME_LON, lats[i], lons[i]);
+            }
+            return distances[count / 2] + bearings[count / 2];
+        });
+
+        const GeoUtils::BatchKernel best = GeoUtils::bestBatchKernel();
+        for (GeoUtils::BatchKernel kernel : {GeoUtils::BATCH_SCALAR, GeoUtils::BATCH_SSE2, GeoUtils::BATCH_AVX2}) {
+            if (kernel > best) break;
+            QString label = QString("geo/fleet/%1/batch-%2").arg(count).arg(GeoUtils::batchKernelName(kernel));
+            measure(label, count, [&]() {
+                GeoUtils::distanceBearingBatch(HOME_LAT, HOME_LON, lats.data(), lons.data(), count,
+                                               distances.data(), bearings.data(), kernel);
+                return distances[count / 2] + bearings[count / 2];
+            });
+        }
+    }
+
+    // The three DistanceEngine tiers and the threshold test over a fleet around the user
+    void benchDistanceEngine(int count) {
+        Rng rng(7);
+        std::vector<double> lats(count), lons(count), distances(count);
+        for (int i = 0; i < count; ++i) {
+            lats[i] = HOME_LAT + rng.uniform(-3.0, 3.0);
+            lons[i] = HOME_LON + rng.uniform(-3.0, 3.0);
+        }
+        const DistanceEngine engine(HOME_LAT, HOME_LON);
+        const char* names[] = {"compare", "display", "exact"};
+
+        const GeoUtils::BatchKernel best = GeoUtils::bestBatchKernel();
+        for (DistanceEngine::Precision precision : {DistanceEngine::COMPARE, DistanceEngine::DISPLAY,
+                                                    DistanceEngine::EXACT}) {
+            for (GeoUtils::BatchKernel kernel : {GeoUtils::BATCH_SCALAR, GeoUtils::BATCH_SSE2, GeoUtils::BATCH_AVX2}) {
+                if (kernel > best) break;
+                QString label = QString("geo/distance/%1/%2-%3").arg(count).arg(names[precision])
+                                .arg(GeoUtils::batchKernelName(kernel));
+                measure(label, count, [&]() {
+                    engine.distances(lats.data(), lons.data(), count, distances.data(), precision, kernel);
+                    return distances[count / 2];
+                });
+            }
+        }
+
+        // Proximity test at the default alert distance
+        constexpr double RADIUS = 10000.0;
+        measure(QString("geo/distance/%1/within-haversine").arg(count), count, [&]() {
+            int inside = 0;
+            for (int i = 0; i < count; ++i) {
+                inside += GeoUtils::calculateDistance(HOME_LAT, HOME_LON, lats[i], lons[i]) <= RADIUS;
+            }
+            return static_cast<double>(inside);
+        });
+        measure(QString("geo/distance/%1/within-engine").arg(count), count, [&]() {
+            int inside = 0;
+            for (int i = 0; i < count; ++i) {
+                inside += engine.within(lats[i], lons[i], RADIUS);
+            }
+            return static_cast<double>(inside);
+        });
+    }
+
+    // Slant range, azimuth and elevation of a fleet: per-target calls against the batch kernels
+    void benchLookAngles(int count) {
+        Rng rng(9);
+        std::vector<double> lats(count), lons(count), alts(count), ranges(count), azimuths(count), elevations(count);
+        for (int i = 0; i < count; ++i) {
+            lats[i] = HOME_LAT + rng.uniform(-3.0, 3.0);
+            lons[i] = HOME_LON + rng.uniform(-3.0, 3.0);
+            alts[i] = rng.uniform(0.0, 12000.0);
+        }
+        const LookAngleEngine engine(HOME_LAT, HOME_LON);
+
+        measure(QString("geo/lookangles/%1/calls").arg(count), count, [&]() {
+            for (int i = 0; i < count; ++i) {
+                LookAngleEngine::LookAngle look = engine.lookAngle(lats[i], lons[i], alts[i]);
+                ranges[i] = look.range;
+                azimuths[i] = look.azimuth;
+                elevations[i] = look.elevation;
+            }
+            return ranges[count / 2] + elevations[count / 2];
+        });
+
+        const GeoUtils::BatchKernel best = GeoUtils::bestBatchKernel();
+        for (GeoUtils::BatchKernel kernel : {GeoUtils::BATCH_SCALAR, GeoUtils::BATCH_SSE2, GeoUtils::BATCH_AVX2}) {
+            if (kernel > best) break;
+            QString label = QString("geo/lookangles/%1/batch-%2").arg(count).arg(GeoUtils::batchKernelName(kernel));
+            measure(label, count, [&]() {
+                engine.lookAngles(lats.data(), lons.data(), alts.data(), count,
+                                  ranges.data(), azimuths.data(), elevations.data(), kernel);
+                return ranges[count / 2] + elevations[count / 2];
+            });
+        }
+    }
+
+    // Spatial index against linear scans: maintenance, radius, k nearest and map viewport
+    void benchSpatialIndex(int count) {
+        Rng rng(10);
+        std::vector<double> lats(count), lons(count);
+        for (int i = 0; i < count; ++i) {
+            lats[i] = HOME_LAT + rng.uniform(-3.0, 3.0);
+            lons[i] = HOME_LON + rng.uniform(-3.0, 3.0);
+        }
+        SpatialIndex index;
+        for (int i = 0; i < count; ++i) {
+            index.update(static_cast<uint32_t>(i), lats[i], lons[i]);
+        }
+        std::vector<uint32_t> found;
+        constexpr double RADIUS = 10000.0;
+        constexpr int NEAREST = 10;
+
+        // About 100 m per update at a few hundred knots, so most stay in their cell
+        double step = 0.001;
+        measure(QString("geo/index/%1/update").arg(count), count, [&]() {
+            step = -step;
+            for (int i = 0; i < count; ++i) {
+                index.update(static_cast<uint32_t>(i), lats[i] + step, lons[i] + step);
+            }
+            return static_cast<double>(index.size());
+        });
+
+        measure(QString("geo/index/%1/radius-scan").arg(count), count, [&]() {
+            const GeoUtils::RadiusFilter filter(HOME_LAT, HOME_LON, RADIUS);
+            found.clear();
+            for (int i = 0; i < count; ++i) {
+                if (filter.contains(lats[i], lons[i])) found.push_back(static_cast<uint32_t>(i));
+            }
+            return static_cast<double>(found.size());
+        });
+        measure(QString("geo/index/%1/radius-index").arg(count), count, [&]() {
+            found.clear();
+            index.queryRadius(HOME_LAT, HOME_LON, RADIUS, found);
+            return static_cast<double>(found.size());
+        });
+
+        std::vector<SpatialIndex::Neighbor> all(count);
+        measure(QString("geo/index/%1/nearest-scan").arg(count), count, [&]() {
+            for (int i = 0; i < count; ++i) {
+                all[i] = {static_cast<uint32_t>(i),
+                          GeoUtils::calculateDistance(HOME_LAT, HOME_LON, lats[i], lons[i])};
+            }
+            std::partial_sort(all.begin(), all.begin() + NEAREST, all.end(),
+                              [](const SpatialIndex::Neighbor& a, const SpatialIndex::Neighbor& b) {
+                                  return a.distance < b.distance;
+                              });
+            return all[0].distance;
+        });
+        measure(QString("geo/index/%1/nearest-index").arg(count), count, [&]() {
+            return index.nearest(HOME_LAT, HOME_LON, NEAREST).front().distance;
+        });
+
+        // MapWidget's default view: 100 m per pixel on 800x600, 100 px margin
+        const MapProjection projection(HOME_LAT, HOME_LON, 100.0, 800.0, 600.0);
+        const GeoUtils::BoundingBox view = projection.bounds(-100.0, -100.0, 900.0, 700.0);
+        measure(QString("geo/index/%1/viewport-scan").arg(count), count, [&]() {
+            found.clear();
+            for (int i = 0; i < count; ++i) {
+                if (view.contains(lats[i], lons[i])) found.push_back(static_cast<uint32_t>(i));
+            }
+            return static_cast<double>(found.size());
+        });
+        measure(QString("geo/index/%1/viewport-index").arg(count), count, [&]() {
+            found.clear();
+            index.queryBox(view, found);
+            return static_cast<double>(found.size());
+        });
+    }
+
+    /**
+     * Worst relative error of COMPARE and DISPLAY against haversine, per
+     * observer latitude and distance, over targets in every direction at
+     * half to full that distance. Also counts threshold tests that disagree
+     * with haversine, which must be zero.
+     */
+    void distanceAccuracy() {
+        if (!selected("accuracy")) return;
+
+        constexpr int TARGETS = 4000;
+        const double latitudes[] = {0.0, 30.0, 45.0, 60.0, 75.0, 85.0, 89.0};
+        const double ranges[] = {100.0, 1000.0, 10000.0, 50000.0, 100000.0, 200000.0, 500000.0};
+        const DistanceEngine::Precision precisions[] = {DistanceEngine::COMPARE, DistanceEngine::DISPLAY};
+        const char* names[] = {"compare", "display"};
+
+        Rng rng(8);
+        long long withinTests = 0;
+        long long withinMismatches = 0;
+        for (DistanceEngine::Precision precision : precisions) {
+            std::fprintf(stderr, "\naccuracy/%s: max relative error vs haversine\n  lat", names[precision]);
+            for (double range : ranges) std::fprintf(stderr, " %9.0fm", range);
+            std::fprintf(stderr, "\n");
+
+            for (double lat0 : latitudes) {
+                const DistanceEngine engine(lat0, HOME_LON);
+                const double phi0 = GeoUtils::toRadians(lat0);
+                std::fprintf(stderr, "  %3.0f", lat0);
+
+                for (double range : ranges) {
+                    double worst = 0.0;
+                    for (int k = 0; k < TARGETS; ++k) {
+                        // Destination at a random bearing, as in TrafficSimulator
+                        double bearing = rng.uniform(0.0, 2.0 * GeoUtils::PI);
+                        double d = range * rng.uniform(0.5, 1.0);
+                        double angular = d / GeoUtils::EARTH_RADIUS;
+                        double phi = std::asin(std::sin(phi0) * std::cos(angular) +
+                                               std::cos(phi0) * std::sin(angular) * std::cos(bearing));
+                        double lon = HOME_LON + GeoUtils::toDegrees(std::atan2(
+                            std::sin(bearing) * std::sin(angular) * std::cos(phi0),
+                            std::cos(angular) - std::sin(phi0) * std::sin(phi)));
+                        if (lon < -180.0) lon += 360.0;
+                        double lat = GeoUtils::toDegrees(phi);
+
+                        double exact = GeoUtils::calculateDistance(lat0, HOME_LON, lat, lon);
+                        double approx = engine.distance(lat, lon, precision);
+                        worst = std::max(worst, std::fabs(approx - exact) / exact);
+
+                        double radius = exact * rng.uniform(0.999, 1.001);
+                        withinMismatches += engine.within(lat, lon, radius) != (exact <= radius);
+                        ++withinTests;
+                    }
+                    std::fprintf(stderr, " %10.1e", worst);
+
+                    QJsonObject row;
+                    row["precision"] = names[precision];
+                    row["latitude"] = lat0;
+                    row["range_m"] = range;
+                    row["max_relative_error"] = worst;
+                    g_accuracy.append(row);
+                }
+                std::fprintf(stderr, "\n");
+            }
+        }
+        std::fprintf(stderr, "accuracy/within: %lld of %lld threshold tests differ from haversine\n\n",
+                     withinMismatches, withinTests);
+    }
+
+    // Alternates two consecutive seconds of traffic, so every pass has changes to publish
+    void benchAircraftParser(const char* name, ADSBClient::Source source,
+                             QByteArray (*document)(const TrafficSimulator&), int count) {
+        QString label = QString("parse/%1/%2").arg(name).arg(count);
+        if (!selected(label)) return;
+
+        TrafficSimulator sim = traffic(count, 2);
+        const QByteArray first = document(sim);
+        sim.step(1.0);
+        const QByteArray second = document(sim);
+
+        ADSBClient client;
+        client.setSource(source);
+        client.setUserLocation(HOME_LAT, HOME_LON);
+        client.setSearchRadius(AREA_RADIUS * 2.0);
+
+        bool flip = false;
+        measure(label, count, [&]() {
+            flip = !flip;
+            client.processDocument(flip ? first : second);
+            return static_cast<double>(client.aircraftVersion());
+        });
+    }
+
+    void benchLaunchParser(int count) {
+        QString label = QString("parse/launchlibrary/%1").arg(count);
+        if (!selected(label)) return;
+
+        const QByteArray document = launchLibraryDocument(count, 3);
+        RocketClient client;
+        measure(label, count, [&]() {
+            client.processDocument(document);
+            return static_cast<double>(client.getRockets()->size());
+        });
+    }
+
+    void benchMapPaint(int count) {
+        QString label = QString("map/paint/%1").arg(count);
+        if (!selected(label)) return;
+
+        TrafficSimulator sim = traffic(count, 4);
+        AircraftTable table;
+        int64_t nowNs = MonotonicClock::nowNs();
+        for (const TrafficSimulator::Target& t : sim.targets()) {
+            applyTarget(table.upsert(t.icao), t, nowNs);
+        }
+        SnapshotStore<AircraftTable> store;
+        store.publish(std::move(table));
+
+        MapWidget map;
+        map.setProximityAlert(false);
+        map.resize(1600, 1000);
+        map.setUserLocation(HOME_LAT, HOME_LON);
+        map.setAircraft(store.current());
+
+        QImage image(map.size(), QImage::Format_ARGB32_Premultiplied);
+        measure(label, count, [&]() {
+            map.render(&image);
+            return static_cast<double>(image.constBits()[0]);
+        });
+    }
+
+    // Drives MainWindow's delta slot the way a feed does: the whole fleet
+    // appears, moves for a few seconds and disappears again
+    class DeltaSource {
+    public:
+        explicit DeltaSource(int count) : m_sim(traffic(count, 5)) {}
+
+        AircraftDelta addAll() {
+            for (const TrafficSimulator::Target& t : m_sim.targets()) upsert(t);
+            return take();
+        }
+
+        AircraftDelta step() {
+            m_sim.step(1.0);
+            for (uint32_t icao : m_sim.departed()) {
+                if (m_table.remove(icao)) m_pending.remove(icao);
+            }
+            m_sim.clearDeparted();
+            for (const TrafficSimulator::Target& t : m_sim.targets()) upsert(t);
+            return take();
+        }
+
+        AircraftDelta removeAll() {
+            for (const Aircraft& ac : m_table) m_pending.remove(ac.getAddress());
+            m_table.clear();
+            return take();
+        }
+
+    private:
+        TrafficSimulator m_sim;
+        AircraftTable m_table;
+        PendingDelta m_pending;
+        SnapshotStore<AircraftTable> m_snapshots;
+
+        void upsert(const TrafficSimulator::Target& t) {
+            bool inserted;
+            Aircraft& ac = m_table.upsert(t.icao, &inserted);
+            const Aircraft before = ac;
+            applyTarget(ac, t, MonotonicClock::nowNs());
+            if (inserted) {
+                m_pending.insert(t.icao);
+            } else {
+                m_pending.change(t.icao, ac.changedFields(before));
+            }
+        }
+
+        AircraftDelta take() {
+            AircraftDelta delta;
+            m_pending.take(m_table, delta);
+            delta.version = m_snapshots.publish(m_table);
+            delta.snapshot = m_snapshots.current();
+            return delta;
+        }
+    };
+
+    void benchAircraftList(MainWindow& window, int count) {
+        const QString prefix = QString("list/%1/").arg(count);
+        const QStringList phases = {"add", "update", "rebuild", "remove"};
+        bool any = false;
+        for (const QString& phase : phases) any = any || selected(prefix + phase);
+        if (!any) return;
+
+        auto apply = [&window](const AircraftDelta& delta) {
+            int64_t start = MonotonicClock::nowNs();
+            QMetaObject::invokeMethod(&window, "onAircraftChanged", Qt::DirectConnection,
+                                      Q_ARG(AircraftDelta, delta));
+            return static_cast<double>(MonotonicClock::nowNs() - start);
+        };
+
+        // Deltas are built outside the timed region; the first round warms up
+        constexpr int UPDATES = 5;
+        std::vector<double> add, update, rebuild, remove;
+        DeltaSource source(count);
+        for (int round = 0; round <= g_settings.samples; ++round) {
+            double addNs = apply(source.addAll());
+
+            double updateNs = 0.0;
+            for (int i = 0; i < UPDATES; ++i) {
+                updateNs += apply(source.step());
+            }
+
+            // A location change re-sorts the whole list
+            int64_t start = MonotonicClock::nowNs();
+            QMetaObject::invokeMethod(&window, "onLocationChanged", Qt::DirectConnection);
+            double rebuildNs = static_cast<double>(MonotonicClock::nowNs() - start);
+
+            double removeNs = apply(source.removeAll());
+
+            if (round == 0) continue;
+            add.push_back(addNs);
+            update.push_back(updateNs / UPDATES);
+            rebuild.push_back(rebuildNs);
+            remove.push_back(removeNs);
+        }
+
+        if (selected(prefix + "add")) report(prefix + "add", count, 1, add);
+        if (selected(prefix + "update")) report(prefix + "update", count, UPDATES, update);
+        if (selected(prefix + "rebuild")) report(prefix + "rebuild", count, 1, rebuild);
+        if (selected(prefix + "remove")) report(prefix + "remove", count, 1, remove);
+    }
+
+    // Every payload of a recording through the client that made it, in order
+    bool benchRecording(const QString& path) {
+        FeedRecording::Reader reader;
+        if (!reader.open(QFile::encodeName(path).toStdString())) {
+            std::fprintf(stderr, "cannot read recording %s\n", qPrintable(path));
+            return false;
+        }
+
+        std::vector<QByteArray> payloads;
+        std::vector<int> kinds;
+        std::vector<char> buffer;
+        for (size_t i = 0; i < reader.count(); ++i) {
+            if (!reader.read(i, buffer)) break;
+            payloads.emplace_back(buffer.data(), static_cast<int>(buffer.size()));
+            kinds.push_back(reader.entry(i).kind);
+        }
+        if (payloads.empty()) return true;
+
+        QString label = QString("replay/%1").arg(QFileInfo(path).fileName());
+        QString tag = QString::fromLatin1(reader.tag()).trimmed();
+        size_t next = 0;
+
+        if (tag == RocketClient::RECORDING_TAG) {
+            RocketClient client;
+            measure(label, 1, [&]() {
+                client.processDocument(payloads[next++ % payloads.size()]);
+                return static_cast<double>(client.getRockets()->size());
+            });
+            return true;
+        }
+
+        ADSBClient client;
+        client.setSource(static_cast<ADSBClient::Source>(reader.source()));
+        client.setUserLocation(HOME_LAT, HOME_LON);
+        client.setSearchRadius(1e7);
+        measure(label, 1, [&]() {
+            size_t i = next++ % payloads.size();
+            if (kinds[i] == FeedRecording::STREAM_BYTES) {
+                client.processStream(payloads[i]);
+            } else {
+                client.processDocument(payloads[i]);
+            }
+            return static_cast<double>(client.aircraftVersion());
+        });
+        return true;
+    }
+
+    QJsonDocument resultsDocument() {
+        QJsonArray results;
+        for (const Result& r : g_results) {
+            QJsonArray samples;
+            for (double ns : r.samplesNs) samples.append(ns);
+            double med = median(r.samplesNs);
+
+            QJsonObject entry;
+            entry["name"] = r.name;
+            entry["items"] = r.items;
+            entry["operations"] = r.operations;
+            entry["median_ns"] = med;
+            entry["min_ns"] = *std::min_element(r.samplesNs.begin(), r.samplesNs.end());
+            entry["max_ns"] = *std::max_element(r.samplesNs.begin(), r.samplesNs.end());
+            entry["ns_per_item"] = r.items > 0 ? med / r.items : med;
+            entry["samples_ns"] = samples;
+            results.append(entry);
+        }
+
+        QJsonObject root;
+        root["suite"] = "tracker_bench";
+        root["format"] = 1;
+        root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["qt"] = QString(qVersion());
+#if defined(__VERSION__)
+        root["compiler"] = QString(__VERSION__);
+#endif
+#ifdef NDEBUG
+        root["assertions"] = false;
+#else
+        root["assertions"] = true;
+#endif
+        root["results"] = results;
+        if (!g_accuracy.isEmpty()) root["accuracy"] = g_accuracy;
+        return QJsonDocument(root);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Widgets are painted into images; no display is needed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QString jsonPath;
+    QStringList recordings;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--json" && i + 1 < args.size()) {
+            jsonPath = args[++i];
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            g_settings.filter = args[++i];
+        } else if (args[i] == "--quick") {
+            g_settings.samples = 3;
+            g_settings.minSampleNs = 10 * MonotonicClock::NS_PER_MS;
+        } else if (args[i].startsWith("--")) {
+            std::fprintf(stderr, "usage: tracker_bench [--json file] [--filter text] [--quick] [recording.rec ...]\n");
+            return 2;
+        } else {
+            recordings.append(args[i]);
+        }
+    }
+
+    benchGeo();
+    for (int count : {10000, 100000}) {
+        benchGeoFleet(count);
+    }
+    for (int count : {10000, 100000}) {
+        benchDistanceEngine(count);
+        benchLookAngles(count);
+        benchSpatialIndex(count);
+    }
+    distanceAccuracy();
+
+    for (int count : {1000, 10000}) {
+        benchAircraftParser("dump1090", ADSBClient::DUMP1090_LOCAL, dump1090Document, count);
+        benchAircraftParser("opensky", ADSBClient::OPENSKY_NETWORK, openSkyDocument, count);
+    }
+    for (int count : {10, 100}) {
+        benchLaunchParser(count);
+    }
+
+    for (int count : {100, 1000, 10000}) {
+        benchMapPaint(count);
+    }
+
+    {
+        // On the GUI thread, without simulated traffic of its own
+        MainWindow::Options options;
+        options.workerThread = false;
+        options.simulation.aircraft = 0;
+        MainWindow window(options);
+        if (MapWidget* map = window.findChild<MapWidget*>()) {
+            map->setProximityAlert(false);   // Alerts open modal dialogs
+        }
+        for (int count : {100, 1000, 10000}) {
+            benchAircraftList(window, count);
+        }
+    }
+
+    for (const QString& path : recordings) {
+        if (!benchRecording(path)) return 1;
+    }
+
+    QByteArray json = resultsDocument().toJson();
+    if (jsonPath.isEmpty()) {
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+    } else {
+        QFile file(jsonPath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+            std::fprintf(stderr, "cannot write %s\n", qPrintable(jsonPath));
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -32,7 +32,11 @@ $MOC ../src/mainwindow.h -o moc_mainwindow.cpp
 $MOC ../src/mapwidget.h -o moc_mapwidget.cpp
 $MOC ../src/gpsnavigator.h -o moc_gpsnavigator.cpp
 $MOC ../src/adsbclient.h -o moc_adsbclient.cpp
+$MOC ../src/aircraftfusion.h -o moc_aircraftfusion.cpp
+$MOC ../src/httppoller.h -o moc_httppoller.cpp
+$MOC ../src/feedreplay.h -o moc_feedreplay.cpp
 $MOC ../src/rocketclient.h -o moc_rocketclient.cpp
+$MOC ../src/trackerdaemon.h -o moc_trackerdaemon.cpp
 $MOC ../src/systemgps.h -o moc_systemgps.cpp
 
 echo "✅ MOC files generated"
@@ -43,18 +47,40 @@ g++ -c -std=c++17 -fPIC $QT_CFLAGS \
     ../src/main.cpp \
     ../src/mainwindow.cpp \
     ../src/aircraft.cpp \
+    ../src/aircrafttable.cpp \
+    ../src/trackhistory.cpp \
+    ../src/timingwheel.cpp \
+    ../src/trafficsimulator.cpp \
     ../src/rocket.cpp \
     ../src/geoutils.cpp \
+    ../src/geoutils_avx2.cpp \
+    ../src/mapprojection.cpp \
+    ../src/distanceengine.cpp \
+    ../src/lookangles.cpp \
+    ../src/spatialindex.cpp \
     ../src/mapwidget.cpp \
     ../src/gpsnavigator.cpp \
     ../src/adsbclient.cpp \
+    ../src/aircraftfusion.cpp \
+    ../src/httppoller.cpp \
+    ../src/feedrecording.cpp \
+    ../src/feedreplay.cpp \
+    ../src/modes.cpp \
+    ../src/cpr.cpp \
+    ../src/sbsparser.cpp \
+    ../src/dump1090json.cpp \
     ../src/rocketclient.cpp \
+    ../src/trackerdaemon.cpp \
     ../src/systemgps.cpp \
     moc_mainwindow.cpp \
     moc_mapwidget.cpp \
     moc_gpsnavigator.cpp \
     moc_adsbclient.cpp \
+    moc_aircraftfusion.cpp \
+    moc_httppoller.cpp \
+    moc_feedreplay.cpp \
     moc_rocketclient.cpp \
+    moc_trackerdaemon.cpp \
     moc_systemgps.cpp
 
 if [ $? -ne 0 ]; then
@@ -71,18 +97,40 @@ g++ -o AircraftRocketTracker \
     main.o \
     mainwindow.o \
     aircraft.o \
+    aircrafttable.o \
+    trackhistory.o \
+    timingwheel.o \
+    trafficsimulator.o \
     rocket.o \
     geoutils.o \
+    geoutils_avx2.o \
+    mapprojection.o \
+    distanceengine.o \
+    lookangles.o \
+    spatialindex.o \
     mapwidget.o \
     gpsnavigator.o \
     adsbclient.o \
+    aircraftfusion.o \
+    httppoller.o \
+    feedrecording.o \
+    feedreplay.o \
+    modes.o \
+    cpr.o \
+    sbsparser.o \
+    dump1090json.o \
     rocketclient.o \
+    trackerdaemon.o \
     systemgps.o \
     moc_mainwindow.o \
     moc_mapwidget.o \
     moc_gpsnavigator.o \
     moc_adsbclient.o \
+    moc_aircraftfusion.o \
+    moc_httppoller.o \
+    moc_feedreplay.o \
     moc_rocketclient.o \
+    moc_trackerdaemon.o \
     moc_systemgps.o \
     $QT_LIBS
 
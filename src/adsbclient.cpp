@@ -1,97 +1,504 @@
 #include "adsbclient.h"
 #include "geoutils.h"
+#include "dump1090json.h"
+#include "monotonicclock.h"
 #include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QRandomGenerator>
+#include <QDateTime>
+#include <QFile>
+#include <algorithm>
+#include <cstring>
 
 ADSBClient::ADSBClient(QObject* parent)
     : QObject(parent),
       m_networkManager(new QNetworkAccessManager(this)),
+      m_poller(new HttpPoller(m_networkManager, this)),
       m_updateTimer(new QTimer(this)),
       m_source(SIMULATED),
+      m_snapshotsEnabled(true),
+      m_expiry(MonotonicClock::NS_PER_SEC, 64),   // 1 s ticks, wider than STALE_SECONDS
       m_userLat(0.0),
       m_userLon(0.0),
-      m_searchRadius(100000.0)  // 100 km default
+      m_searchRadius(100000.0),  // 100 km default
+      m_socket(new QTcpSocket(this)),
+      m_publishTimer(new QTimer(this)),
+      m_streamHost("localhost"),
+      m_streamPort(0),
+      m_replay(new FeedReplay(this)),
+      m_replayFormat(SIMULATED),
+      m_replayEpochNs(0),
+      m_replayNowNs(0),
+      m_simulateStream(false)
 {
     connect(m_updateTimer, &QTimer::timeout, this, &ADSBClient::fetchData);
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &ADSBClient::handleNetworkReply);
+    connect(m_poller, &HttpPoller::dataReceived, this, &ADSBClient::handlePolledData);
+    connect(m_poller, &HttpPoller::notModified, this, [this]() {
+        // Nothing to parse, but aircraft still age out
+        removeStaleAircraft();
+        publishAircraft();
+    });
+    connect(m_poller, &HttpPoller::failed, this, [this](const QString& message) {
+        // A feed that stays down must not freeze its aircraft on the map
+        removeStaleAircraft();
+        publishAircraft();
+        emit error(QString("Network error: %1").arg(message));
+    });
+    
+    connect(m_socket, &QTcpSocket::readyRead, this, &ADSBClient::handleStreamData);
+    connect(m_socket, &QAbstractSocket::errorOccurred,
+            this, &ADSBClient::handleStreamError);
+    connect(m_publishTimer, &QTimer::timeout, this, &ADSBClient::publishAircraft);
+    
+    connect(m_replay, &FeedReplay::payload, this, &ADSBClient::handleReplayPayload);
+    connect(m_replay, &FeedReplay::finished, this, [this]() {
+        publishAircraft();
+        emit replayFinished();
+    });
     
     setUpdateInterval(5000); // Update every 5 seconds
+    m_publishTimer->setInterval(500); // Stream sources publish twice a second
 }
 
 void ADSBClient::setUpdateInterval(int msec) {
     m_updateTimer->setInterval(msec);
+    m_poller->setInterval(msec);    // Stretches up to 8x while nothing changes
 }
 
 void ADSBClient::setUserLocation(double lat, double lon) {
     m_userLat = lat;
     m_userLon = lon;
+    
+    // The OpenSky bounding box follows the user and the search radius
+    if (m_source == OPENSKY_NETWORK) {
+        m_poller->setRequest(pollRequest());
+    } else if (m_source == SIMULATED && m_updateTimer->isActive()) {
+        m_simulator.setArea(m_userLat, m_userLon, m_searchRadius);
+    }
+}
+
+void ADSBClient::setSearchRadius(double meters) {
+    m_searchRadius = meters;
+    if (m_source == OPENSKY_NETWORK) {
+        m_poller->setRequest(pollRequest());
+    } else if (m_source == SIMULATED && m_updateTimer->isActive()) {
+        m_simulator.setArea(m_userLat, m_userLon, m_searchRadius);
+    }
+}
+
+void ADSBClient::setSimulation(const TrafficSimulator::Config& config, bool rawStream) {
+    m_simulator.setConfig(config);
+    m_simulateStream = rawStream;
+}
+
+void ADSBClient::setStreamEndpoint(const QString& host, quint16 port) {
+    m_streamHost = host;
+    m_streamPort = port;
+}
+
+void ADSBClient::setReplayFile(const QString& path, double speed) {
+    m_replayPath = path;
+    m_replay->setSpeed(speed);
 }
 
 void ADSBClient::start() {
+    if (m_source == REPLAY) {
+        if (!startReplay()) return;
+        
+        // Payloads arrive from the replay; the timer only expires aircraft
+        m_updateTimer->start();
+        if (isStreamFormat(m_replayFormat)) {
+            m_publishTimer->start();
+        }
+        return;
+    }
+    
+    // Only payloads are recorded, so a simulation is recordable as a stream
+    Source format = feedFormat();
+    if (!m_recordPath.isEmpty() && (isPolledFormat(format) || isStreamFormat(format))) {
+        if (!m_recorder.open(QFile::encodeName(m_recordPath).toStdString(), RECORDING_TAG, format)) {
+            emit error(QString("Cannot write recording %1").arg(m_recordPath));
+        }
+    }
+    
+    if (isPolledSource()) {
+        m_poller->setRequest(pollRequest());
+        m_poller->start();
+        return;
+    }
+    
+    if (m_source == SIMULATED) {
+        m_simulator.reset(m_userLat, m_userLon, m_searchRadius);
+        m_simulator.clearDeparted();
+        m_streamBuffer.clear();
+    }
+    
     m_updateTimer->start();
+    if (isStreamSource()) {
+        m_publishTimer->start();
+    }
     fetchData(); // Immediate first fetch
 }
 
 void ADSBClient::stop() {
+    m_poller->stop();
+    m_replay->stop();
+    m_recorder.close();
     m_updateTimer->stop();
+    m_publishTimer->stop();
+    m_socket->abort();
+    m_streamBuffer.clear();
+    
+    // The next source starts from an empty table, on MonotonicClock time even
+    // if a replay clock ran ahead of it
+    clearAircraft();
+    m_expiry.restart(MonotonicClock::nowNs());
+    publishAircraft();
+}
+
+QNetworkRequest ADSBClient::pollRequest() const {
+    if (m_source == OPENSKY_NETWORK) {
+        // OpenSky Network API - Free, no API key needed!
+        // Smallest box around the search circle, so nothing outside it is downloaded
+        GeoUtils::BoundingBox box = GeoUtils::boundingBox(m_userLat, m_userLon, m_searchRadius);
+        if (box.wrapsAntimeridian()) {
+            // The API takes a single box; fetch the whole latitude band instead
+            box.minLon = -180.0;
+            box.maxLon = 180.0;
+        }
+        
+        QString url = QString("https://opensky-network.org/api/states/all?"
+                            "lamin=%1&lomin=%2&lamax=%3&lomax=%4")
+                        .arg(box.minLat, 0, 'f', 4)
+                        .arg(box.minLon, 0, 'f', 4)
+                        .arg(box.maxLat, 0, 'f', 4)
+                        .arg(box.maxLon, 0, 'f', 4);
+        return QNetworkRequest(QUrl(url));
+    }
+    
+    // Local dump1090 server (requires RTL-SDR hardware)
+    return QNetworkRequest(QUrl("http://localhost:8080/data/aircraft.json"));
 }
 
 void ADSBClient::fetchData() {
     switch (m_source) {
-        case OPENSKY_NETWORK: {
-            // OpenSky Network API - Free, no API key needed!
-            // Bounding box around user location
-            double latRange = 1.0; // ~111 km
-            double lonRange = 1.0;
-            
-            QString url = QString("https://opensky-network.org/api/states/all?"
-                                "lamin=%1&lomin=%2&lamax=%3&lomax=%4")
-                            .arg(m_userLat - latRange)
-                            .arg(m_userLon - lonRange)
-                            .arg(m_userLat + latRange)
-                            .arg(m_userLon + lonRange);
-            
-            QNetworkRequest request(url);
-            m_networkManager->get(request);
+        case OPENSKY_NETWORK:
+        case DUMP1090_LOCAL:
+            // Scheduled by the poller; this only forces an early request
+            m_poller->pollNow();
             break;
-        }
         
-        case DUMP1090_LOCAL: {
-            // Local dump1090 server (requires RTL-SDR hardware)
-            QNetworkRequest request(QUrl("http://localhost:8080/data/aircraft.json"));
-            m_networkManager->get(request);
+        case BEAST_TCP:
+        case SBS_TCP:
+        case AVR_TCP:
+            // Persistent stream; the update timer only expires silent aircraft and
+            // re-establishes a dropped connection
+            removeStaleAircraft();
+            connectStream();
+            break;
+        
+        case REPLAY:
+            // Expire on the replay clock, as far as playback has got
+            advanceReplayClock(m_replay->positionNs());
+            removeStaleAircraft();
+            publishAircraft();
             break;
-        }
         
         case SIMULATED:
         default:
-            generateSimulatedData();
+            simulateTraffic();
             break;
     }
 }
 
-void ADSBClient::handleNetworkReply(QNetworkReply* reply) {
-    reply->deleteLater();
+bool ADSBClient::startReplay() {
+    if (!m_replay->open(m_replayPath)) {
+        emit error(QString("Cannot read recording %1").arg(m_replayPath));
+        return false;
+    }
     
-    if (reply->error() != QNetworkReply::NoError) {
-        emit error(QString("Network error: %1").arg(reply->errorString()));
-        return;
+    Source format = static_cast<Source>(m_replay->source());
+    if (m_replay->tag() != RECORDING_TAG || !(isPolledFormat(format) || isStreamFormat(format))) {
+        m_replay->close();
+        emit error(QString("%1 is not an ADS-B recording").arg(m_replayPath));
+        return false;
     }
     
-    QByteArray data = reply->readAll();
+    m_replayFormat = format;
+    m_streamBuffer.clear();
+    m_replayEpochNs = MonotonicClock::nowNs();
+    m_replayNowNs = m_replayEpochNs;
+    m_expiry.restart(m_replayEpochNs);
+    m_replay->start();
+    return true;
+}
+
+void ADSBClient::advanceReplayClock(int64_t recordingNs) {
+    m_replayNowNs = std::max(m_replayNowNs, m_replayEpochNs + recordingNs);
+}
+
+void ADSBClient::record(FeedRecording::Kind kind, const QByteArray& data) {
+    if (!m_recorder.isOpen()) return;
     
-    if (m_source == OPENSKY_NETWORK) {
+    if (!m_recorder.append(kind, data.constData(), static_cast<size_t>(data.size()),
+                           MonotonicClock::nowNs())) {
+        m_recorder.close();
+        emit error(QString("Recording to %1 stopped: write failed").arg(m_recordPath));
+    }
+}
+
+void ADSBClient::handlePolledData(const QByteArray& data) {
+    record(FeedRecording::HTTP_BODY, data);
+    processDocument(data);
+}
+
+void ADSBClient::handleReplayPayload(int kind, qint64 timeNs, const QByteArray& data) {
+    // Everything due before the payload arrived expires first, as it did live
+    advanceReplayClock(timeNs);
+    removeStaleAircraft();
+    
+    if (kind == FeedRecording::STREAM_BYTES) {
+        processStream(data);
+    } else {
+        processDocument(data);
+    }
+}
+
+void ADSBClient::processDocument(const QByteArray& data) {
+    Source format = feedFormat();
+    if (format == OPENSKY_NETWORK) {
         parseOpenSkyData(data);
-    } else if (m_source == DUMP1090_LOCAL) {
+    } else if (format == DUMP1090_LOCAL) {
         parseDump1090Data(data);
     }
 }
 
+void ADSBClient::connectStream() {
+    if (m_socket->state() != QAbstractSocket::UnconnectedState) return;
+    
+    quint16 port = m_streamPort;
+    if (port == 0) {
+        switch (m_source) {
+            case SBS_TCP: port = 30003; break;
+            case AVR_TCP: port = 30002; break;
+            default:      port = 30005; break;
+        }
+    }
+    
+    m_streamBuffer.clear();
+    m_socket->connectToHost(m_streamHost, port);
+}
+
+void ADSBClient::handleStreamError(QAbstractSocket::SocketError socketError) {
+    Q_UNUSED(socketError);
+    emit error(QString("Stream error: %1").arg(m_socket->errorString()));
+}
+
+void ADSBClient::handleStreamData() {
+    QByteArray data = m_socket->readAll();
+    record(FeedRecording::STREAM_BYTES, data);
+    processStream(data);
+}
+
+void ADSBClient::processStream(const QByteArray& data) {
+    m_streamBuffer.append(data);
+    
+    // Messages are decoded in place; only the unconsumed tail is kept
+    Source format = feedFormat();
+    size_t consumed = 0;
+    if (format == BEAST_TCP) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(m_streamBuffer.constData());
+        consumed = m_beastParser.parse(bytes, m_streamBuffer.size(),
+                                       [this](const Beast::Frame& frame) {
+            handleBeastFrame(frame);
+        });
+    } else if (format == SBS_TCP) {
+        consumed = Sbs::parse(m_streamBuffer.constData(), m_streamBuffer.size(),
+                              [this](const Sbs::Message& msg) {
+            applySbsMessage(msg);
+        });
+    } else if (format == AVR_TCP) {
+        consumed = ModeS::parseAvrStream(m_streamBuffer.constData(), m_streamBuffer.size(),
+                                         [this](const uint8_t* frame, int length) {
+            processRawFrame(frame, length);
+        });
+    }
+    
+    m_streamBuffer.remove(0, static_cast<int>(consumed));
+}
+
+Aircraft& ADSBClient::aircraftFor(uint32_t icao) {
+    bool inserted;
+    Aircraft& ac = m_aircraft.upsert(icao, &inserted);
+    if (inserted) {
+        m_pending.insert(icao);
+    }
+    return ac;
+}
+
+void ADSBClient::markChanged(uint32_t icao, uint32_t fields) {
+    m_pending.change(icao, fields);
+}
+
+void ADSBClient::scheduleExpiry(const Aircraft& ac) {
+    m_expiry.schedule(ac.getAddress(), ac.getLastSeen() + Aircraft::STALE_NS);
+}
+
+void ADSBClient::removeAircraft(uint32_t icao) {
+    if (m_aircraft.remove(icao)) {
+        forgetAircraft(icao);
+    }
+}
+
+void ADSBClient::forgetAircraft(uint32_t icao) {
+    m_expiry.cancel(icao);
+    m_pending.remove(icao);
+}
+
+void ADSBClient::clearAircraft() {
+    for (const Aircraft& ac : m_aircraft) {
+        forgetAircraft(ac.getAddress());
+    }
+    m_aircraft.clear();
+}
+
+void ADSBClient::handleBeastFrame(const Beast::Frame& frame) {
+    if (frame.type != '2' && frame.type != '3') return; // Mode A/C carries no address
+    processRawFrame(frame.data, frame.length);
+}
+
+void ADSBClient::processRawFrame(const uint8_t* frame, int length) {
+    ModeS::Message msg;
+    if (ModeS::decode(frame, length, msg)) {
+        applyModeSMessage(msg);
+        return;
+    }
+    
+    // Only extended squitters are worth repairing; the input buffer stays untouched
+    if ((msg.df != 17 && msg.df != 18) || length != ModeS::LONG_MSG_BYTES) return;
+    
+    uint8_t repaired[ModeS::LONG_MSG_BYTES];
+    std::memcpy(repaired, frame, length);
+    if (m_errorCorrector.correct(repaired, length) > 0 &&
+        ModeS::decode(repaired, length, msg)) {
+        applyModeSMessage(msg);
+    }
+}
+
+void ADSBClient::applyModeSMessage(const ModeS::Message& msg) {
+    Aircraft& ac = aircraftFor(msg.icao);
+    const Aircraft before = ac;
+    
+    if (msg.hasCallsign) {
+        ac.setCallsign(msg.callsign);
+    }
+    if (msg.hasAltitude) {
+        ac.setAltitude(GeoUtils::feetToMeters(msg.altitudeFt));
+    }
+    if (msg.hasVelocity) {
+        ac.setVelocity(GeoUtils::knotsToMetersPerSecond(msg.groundSpeedKt));
+        ac.setHeading(msg.trackDeg);
+    }
+    if (msg.hasVerticalRate) {
+        ac.setVerticalRate(GeoUtils::feetToMeters(msg.verticalRateFpm) / 60.0);
+    }
+    
+    if (msg.hasCpr) {
+        applyCprPosition(ac, msg);
+    }
+    
+    ac.setLastSeen(clockNs());
+    scheduleExpiry(ac);
+    markChanged(msg.icao, ac.changedFields(before));
+}
+
+void ADSBClient::applyCprPosition(Aircraft& ac, const ModeS::Message& msg) {
+    // Local decodes are trusted relative to a fix from the last 30 s
+    constexpr qint64 LOCAL_REFERENCE_MS = 30000;
+    
+    int64_t now = clockNs() / MonotonicClock::NS_PER_MS;
+    CPR::FrameState& state = ac.cprState();
+    state.record(msg.cprOdd, msg.cprLat, msg.cprLon, msg.cprSurface, now);
+    
+    double lat, lon;
+    bool decoded = false;
+    
+    if (state.hasPair()) {
+        decoded = CPR::decodeGlobal(state, m_userLat, m_userLon, lat, lon);
+    }
+    
+    if (!decoded && ac.hasPosition() && now - state.lastFixMs < LOCAL_REFERENCE_MS) {
+        decoded = CPR::decodeLocal(msg.cprLat, msg.cprLon, msg.cprOdd, msg.cprSurface,
+                                   ac.getLatitude(), ac.getLongitude(), lat, lon);
+    }
+    
+    if (!decoded && msg.cprSurface) {
+        // Surface targets are always close to the receiver, so it can serve as the
+        // reference. Airborne targets may be further out than half a zone, where a
+        // local decode silently picks the wrong zone; they wait for a global fix.
+        decoded = CPR::decodeLocal(msg.cprLat, msg.cprLon, msg.cprOdd, msg.cprSurface,
+                                   m_userLat, m_userLon, lat, lon);
+    }
+    
+    if (decoded) {
+        // Decoded from the frame just received, so the fix is as of now
+        ac.setPosition(lat, lon, now * MonotonicClock::NS_PER_MS);
+        state.lastFixMs = now;
+    }
+}
+
+void ADSBClient::applySbsMessage(const Sbs::Message& msg) {
+    Aircraft& ac = aircraftFor(msg.icao);
+    const Aircraft before = ac;
+    
+    // Each MSG type only fills its own columns; merge whatever is present
+    if (msg.hasCallsign) {
+        ac.setCallsign(msg.callsign);
+    }
+    if (msg.hasAltitude) {
+        ac.setAltitude(GeoUtils::feetToMeters(msg.altitudeFt));
+    }
+    if (msg.hasVelocity) {
+        ac.setVelocity(GeoUtils::knotsToMetersPerSecond(msg.groundSpeedKt));
+        ac.setHeading(msg.trackDeg);
+    }
+    if (msg.hasVerticalRate) {
+        ac.setVerticalRate(GeoUtils::feetToMeters(msg.verticalRateFpm) / 60.0);
+    }
+    if (msg.hasSquawk) {
+        ac.setSquawk(msg.squawk);
+    }
+    if (msg.hasPosition) {
+        ac.setPosition(msg.lat, msg.lon, clockNs());
+    }
+    
+    ac.setLastSeen(clockNs());
+    scheduleExpiry(ac);
+    markChanged(msg.icao, ac.changedFields(before));
+}
+
+void ADSBClient::publishAircraft() {
+    if (m_pending.isEmpty()) return;
+    
+    AircraftDelta delta;
+    if (m_snapshotsEnabled) {
+        delta.version = m_snapshots.publish(m_aircraft, [this](AircraftTable& older) {
+            m_pending.catchUp(m_aircraft, older);
+        });
+        delta.snapshot = m_snapshots.current();
+    }
+    m_pending.take(m_aircraft, delta);
+    
+    emit aircraftChanged(delta);
+    if (m_snapshotsEnabled) emit aircraftUpdated(delta.snapshot);
+    
+    const ModeS::ErrorCorrector::Stats& fec = m_errorCorrector.stats();
+    if (fec.corrected1 + fec.corrected2 + fec.failed > 0) {
+        emit errorCorrectionUpdated(fec.corrected1 + fec.corrected2, fec.failed);
+    }
+}
+
 void ADSBClient::parseOpenSkyData(const QByteArray& data) {
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (!doc.isObject()) return;
@@ -99,107 +506,161 @@ void ADSBClient::parseOpenSkyData(const QByteArray& data) {
     QJsonObject root = doc.object();
     QJsonArray states = root["states"].toArray();
     
-    m_aircraft.clear();
+    // Box, then flat-earth distance, then haversine only near the edge
+    const GeoUtils::RadiusFilter inRange(m_userLat, m_userLon, m_searchRadius);
+    
+    // last_contact is wall-clock time. Its age is taken against the response's
+    // own timestamp, which keeps local clock skew out and a replay deterministic.
+    int64_t nowNs = clockNs();
+    qint64 wallNowMs = root.contains("time")
+        ? static_cast<qint64>(root["time"].toDouble() * 1000.0)
+        : QDateTime::currentMSecsSinceEpoch();
     
     for (const QJsonValue& value : states) {
         QJsonArray state = value.toArray();
         if (state.size() < 17) continue;
         
-        QString icao = state[0].toString();
-        QString callsign = state[1].toString().trimmed();
+        uint32_t icao;
+        if (!Aircraft::parseAddress(state[0].toString(), icao)) continue;
+        
+        // Aircraft that left the search radius are dropped right away
+        if (!state[5].isNull() && !state[6].isNull() &&
+            !inRange.contains(state[6].toDouble(), state[5].toDouble())) {
+            removeAircraft(icao);
+            continue;
+        }
         
-        // Check for valid position
-        if (state[5].isNull() || state[6].isNull()) continue;
+        Aircraft& ac = aircraftFor(icao);
+        const Aircraft before = ac;
         
-        double lon = state[5].toDouble();
-        double lat = state[6].toDouble();
-        double altitude = state[7].toDouble(0.0); // meters (barometric altitude)
-        double velocity = state[9].toDouble(0.0); // m/s
-        double heading = state[10].toDouble(0.0); // degrees
-        double verticalRate = state[11].toDouble(0.0); // m/s
+        // State vector fields are null when unknown; those keep their previous value
+        if (!state[1].isNull()) ac.setCallsign(state[1].toString().trimmed());
+        if (!state[5].isNull() && !state[6].isNull()) {
+            // time_position (Unix seconds) dates the fix; other messages refresh last_contact
+            const QJsonValue fixTime = state[3].isNull() ? state[4] : state[3];
+            qint64 ageMs = fixTime.isNull()
+                ? 0 : wallNowMs - static_cast<qint64>(fixTime.toDouble() * 1000.0);
+            ac.setPosition(state[6].toDouble(), state[5].toDouble(), nowNs - ageMs * MonotonicClock::NS_PER_MS);
+        }
+        if (!state[7].isNull()) ac.setAltitude(state[7].toDouble());       // meters (barometric)
+        if (!state[9].isNull()) ac.setVelocity(state[9].toDouble());       // m/s
+        if (!state[10].isNull()) ac.setHeading(state[10].toDouble());      // degrees
+        if (!state[11].isNull()) ac.setVerticalRate(state[11].toDouble()); // m/s
+        if (!state[14].isNull()) ac.setSquawk(state[14].toString().toInt());
         
-        // Filter by distance from user
-        double distance = GeoUtils::calculateDistance(m_userLat, m_userLon, lat, lon);
-        if (distance > m_searchRadius) continue;
+        // last_contact (Unix seconds) rather than the poll time drives staleness
+        if (!state[4].isNull()) {
+            qint64 ageMs = wallNowMs - static_cast<qint64>(state[4].toDouble() * 1000.0);
+            ac.setLastSeen(nowNs - ageMs * MonotonicClock::NS_PER_MS);
+        } else {
+            ac.setLastSeen(nowNs);
+        }
+        scheduleExpiry(ac);
         
-        Aircraft aircraft(icao, callsign, lat, lon, altitude, velocity, heading);
-        aircraft.setVerticalRate(verticalRate);
-        m_aircraft[icao] = aircraft;
+        markChanged(icao, ac.changedFields(before));
     }
     
-    emit aircraftUpdated(m_aircraft);
+    removeStaleAircraft();
+    publishAircraft();
 }
 
 void ADSBClient::parseDump1090Data(const QByteArray& data) {
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (!doc.isObject()) return;
+    // Pull parser: no DOM, unknown keys are skipped in place
+    Dump1090Json::Reader reader(data.constData(), static_cast<size_t>(data.size()));
+    Dump1090Json::Entry entry;
+    int64_t nowNs = clockNs();
     
-    QJsonObject root = doc.object();
-    QJsonArray aircraft = root["aircraft"].toArray();
-    
-    m_aircraft.clear();
-    
-    for (const QJsonValue& value : aircraft) {
-        QJsonObject obj = value.toObject();
+    while (reader.next(entry)) {
+        uint32_t icao = entry.nonIcao ? (entry.icao | Aircraft::NON_ICAO_FLAG) : entry.icao;
+        
+        // aircraft.json keeps entries for minutes after the last message
+        if (entry.seen > Aircraft::STALE_SECONDS) {
+            removeAircraft(icao);
+            continue;
+        }
         
-        QString icao = obj["hex"].toString();
-        QString callsign = obj["flight"].toString().trimmed();
+        Aircraft& ac = aircraftFor(icao);
+        const Aircraft before = ac;
         
-        if (!obj.contains("lat") || !obj.contains("lon")) continue;
+        // Fields missing from the entry keep their previous value
+        if (entry.hasCallsign) ac.setCallsign(entry.callsign);
+        if (entry.hasPosition) {
+            // "seen_pos" dates the fix; "seen" is refreshed by every message
+            double age = entry.seenPos >= 0.0 ? entry.seenPos : entry.seen;
+            ac.setPosition(entry.lat, entry.lon, nowNs - static_cast<int64_t>(age * MonotonicClock::NS_PER_SEC));
+        }
+        if (entry.hasAltitude) ac.setAltitude(GeoUtils::feetToMeters(entry.altitudeFt));
+        else if (entry.onGround) ac.setAltitude(0.0);
+        if (entry.hasGroundSpeed) ac.setVelocity(GeoUtils::knotsToMetersPerSecond(entry.groundSpeedKt));
+        if (entry.hasTrack) ac.setHeading(entry.trackDeg);
+        if (entry.hasVerticalRate) ac.setVerticalRate(GeoUtils::feetToMeters(entry.verticalRateFpm) / 60.0);
+        if (entry.hasSquawk) ac.setSquawk(entry.squawk);
         
-        double lat = obj["lat"].toDouble();
-        double lon = obj["lon"].toDouble();
-        double altitude = GeoUtils::feetToMeters(obj["altitude"].toDouble(0.0));
-        double velocity = GeoUtils::knotsToMetersPerSecond(obj["gs"].toDouble(0.0));
-        double heading = obj["track"].toDouble(0.0);
+        // "seen" is the number of seconds since the receiver last heard this aircraft
+        ac.setLastSeen(nowNs - static_cast<int64_t>(entry.seen * MonotonicClock::NS_PER_SEC));
+        scheduleExpiry(ac);
         
-        Aircraft ac(icao, callsign, lat, lon, altitude, velocity, heading);
-        m_aircraft[icao] = ac;
+        markChanged(icao, ac.changedFields(before));
+    }
+    
+    if (reader.hasError()) {
+        emit error("Malformed aircraft.json from dump1090");
     }
     
-    emit aircraftUpdated(m_aircraft);
+    removeStaleAircraft();
+    publishAircraft();
 }
 
-void ADSBClient::generateSimulatedData() {
-    // Generate 3-8 simulated aircraft around user location
-    int numAircraft = QRandomGenerator::global()->bounded(3, 9);
-    
-    m_aircraft.clear();
+void ADSBClient::simulateTraffic() {
+    // Fixed steps, so the traffic only depends on the seed and the tick count
+    m_simulator.step(m_updateTimer->interval() / 1000.0);
+    int64_t nowNs = MonotonicClock::nowNs();
     
-    for (int i = 0; i < numAircraft; ++i) {
-        // Generate position within search radius
-        double distance = 5000.0 + (QRandomGenerator::global()->bounded(static_cast<int>(m_searchRadius - 5000.0)));
-        double bearing = QRandomGenerator::global()->bounded(360);
+    if (m_simulateStream) {
+        // Like a real SBS feed: departures simply fall silent and expire
+        m_simulator.clearDeparted();
+        m_simulatorOutput.clear();
+        m_simulator.writeSbs(m_simulatorOutput);
         
-        // Calculate lat/lon offset
-        double dLat = (distance / GeoUtils::EARTH_RADIUS) * std::cos(GeoUtils::toRadians(bearing));
-        double dLon = (distance / GeoUtils::EARTH_RADIUS) * std::sin(GeoUtils::toRadians(bearing));
-        
-        double lat = m_userLat + GeoUtils::toDegrees(dLat);
-        double lon = m_userLon + GeoUtils::toDegrees(dLon);
-        
-        // Generate realistic parameters
-        double altitude = 3000.0 + QRandomGenerator::global()->bounded(9000); // 3-12 km
-        double velocity = 100.0 + QRandomGenerator::global()->bounded(150); // 100-250 m/s
-        double heading = QRandomGenerator::global()->bounded(360);
+        QByteArray data = QByteArray::fromRawData(m_simulatorOutput.data(),
+                                                  static_cast<int>(m_simulatorOutput.size()));
+        record(FeedRecording::STREAM_BYTES, data);
+        processStream(data);
+        removeStaleAircraft();
+        publishAircraft();
+        return;
+    }
+    
+    for (uint32_t icao : m_simulator.departed()) {
+        removeAircraft(icao);
+    }
+    m_simulator.clearDeparted();
+    
+    for (const TrafficSimulator::Target& target : m_simulator.targets()) {
+        Aircraft& ac = aircraftFor(target.icao);
+        const Aircraft before = ac;
         
-        QString icao = QString("SIM%1").arg(i, 3, 10, QChar('0'));
-        QString callsign = QString("FL%1").arg(QRandomGenerator::global()->bounded(100, 999));
+        if (ac.getCallsign().isEmpty()) {
+            ac.setCallsign(QString::fromLatin1(target.callsign));
+        }
+        ac.setPosition(target.lat, target.lon, nowNs);
+        ac.setAltitude(target.altitude);
+        ac.setVelocity(target.speed);
+        ac.setHeading(target.heading);
+        ac.setVerticalRate(target.verticalRate);
+        ac.setLastSeen(nowNs);
+        scheduleExpiry(ac);
         
-        Aircraft aircraft(icao, callsign, lat, lon, altitude, velocity, heading);
-        m_aircraft[icao] = aircraft;
+        markChanged(target.icao, ac.changedFields(before));
     }
     
-    emit aircraftUpdated(m_aircraft);
+    publishAircraft();
 }
 
 void ADSBClient::removeStaleAircraft() {
-    QMutableMapIterator<QString, Aircraft> it(m_aircraft);
-    while (it.hasNext()) {
-        it.next();
-        if (it.value().isStale()) {
-            it.remove();
-        }
-    }
+    // Only addresses whose deadline has passed are visited, not the whole table
+    m_expiry.advance(clockNs(), [this](uint32_t icao) {
+        removeAircraft(icao);
+    });
 }
 
@@ -4,8 +4,19 @@
 #include <QObject>
 #include <QNetworkAccessManager>
 #include <QTimer>
-#include <QMap>
+#include <QTcpSocket>
 #include "aircraft.h"
+#include "aircrafttable.h"
+#include "aircraftdelta.h"
+#include "snapshotstore.h"
+#include "timingwheel.h"
+#include "httppoller.h"
+#include "feedrecording.h"
+#include "feedreplay.h"
+#include "trafficsimulator.h"
+#include "beastparser.h"
+#include "modes.h"
+#include "sbsparser.h"
 
 /**
  * ADS-B Client - Fetches real-time aircraft data
@@ -14,6 +25,15 @@
  * 1. Local dump1090 server (if you have RTL-SDR receiver)
  * 2. OpenSky Network API (free, no API key needed)
  * 3. ADS-B Exchange API (requires API key)
+ * 4. Beast binary stream from dump1090/readsb (port 30005)
+ * 5. SBS-1 / BaseStation CSV stream (port 30003)
+ * 6. AVR raw frame stream (port 30002), decoded by the built-in Mode S decoder
+ * 7. A recording of any of the above, played back at recorded pace or faster
+ *
+ * Every payload received from the network (HTTP bodies, stream reads) can be
+ * written to a FeedRecording as it arrives, so identical traffic can be
+ * replayed later through the same parsers. A replay runs on recorded time,
+ * so expiry and CPR pairing see the recorded gaps at any speed.
  */
 class ADSBClient : public QObject {
     Q_OBJECT
@@ -22,35 +42,124 @@ public:
     enum Source {
         DUMP1090_LOCAL,     // Local dump1090 server (http://localhost:8080)
         OPENSKY_NETWORK,    // OpenSky Network API
-        SIMULATED           // Simulated data for testing
+        SIMULATED,          // Seeded TrafficSimulator traffic for testing
+        BEAST_TCP,          // Beast binary stream (localhost:30005)
+        SBS_TCP,            // SBS-1 BaseStation CSV stream (localhost:30003)
+        AVR_TCP,            // AVR raw frames "*8D...;" (localhost:30002)
+        REPLAY              // FeedRecording of one of the network sources
     };
     
+    static constexpr const char* RECORDING_TAG = "adsb";
+    
     explicit ADSBClient(QObject* parent = nullptr);
     ~ADSBClient() override = default;
     
     void setSource(Source source) { m_source = source; }
+    Source source() const { return m_source; }
     void setUpdateInterval(int msec);
     void setUserLocation(double lat, double lon);
-    void setSearchRadius(double meters) { m_searchRadius = meters; }
+    void setSearchRadius(double meters);
+    void setStreamEndpoint(const QString& host, quint16 port = 0);
+    
+    /**
+     * Record every payload received from the next start() on
+     *
+     * Only network sources produce payloads. An empty path stops recording;
+     * the file is finished by stop().
+     */
+    void setRecordFile(const QString& path) { m_recordPath = path; }
+    
+    // Recording played by the REPLAY source; speed as in FeedReplay::setSpeed()
+    void setReplayFile(const QString& path, double speed = 1.0);
+    
+    /**
+     * Traffic of the SIMULATED source, applied from the next start()
+     *
+     * The simulator advances by the update interval each tick, so a seed
+     * gives the same traffic regardless of timer jitter. With rawStream it
+     * is rendered as SBS-1 lines and decoded like a port 30003 feed (and
+     * recorded as one), exercising the parser as well.
+     */
+    void setSimulation(const TrafficSimulator::Config& config, bool rawStream = false);
+    
+    /**
+     * Publish snapshots for getAircraft() and aircraftUpdated() (the default)
+     *
+     * A client whose deltas are merged elsewhere, as in AircraftFusion, turns
+     * this off: it then only emits aircraftChanged(), with a null snapshot,
+     * and keeps no published copy of its table.
+     */
+    void setSnapshotsEnabled(bool enabled) { m_snapshotsEnabled = enabled; }
     
     void start();
     void stop();
     
-    QMap<QString, Aircraft> getAircraft() const { return m_aircraft; }
+    // Last published table; safe to call from any thread
+    AircraftSnapshot getAircraft() const { return m_snapshots.current(); }
+    uint64_t aircraftVersion() const { return m_snapshots.version(); }
+    
+    // Feed one raw 56/112-bit Mode S frame through the built-in decoder
+    void processRawFrame(const uint8_t* frame, int length);
+    
+    // Feed one HTTP body (OpenSky, dump1090) or stream read (Beast, SBS-1, AVR)
+    // through the parser of the current source, as if it had just arrived
+    void processDocument(const QByteArray& data);
+    void processStream(const QByteArray& data);
+    
+    // CRC error correction for raw frames (Beast/AVR sources)
+    void setErrorCorrection(ModeS::ErrorCorrector::Mode mode) { m_errorCorrector.setMode(mode); }
+    const ModeS::ErrorCorrector::Stats& errorCorrectionStats() const { return m_errorCorrector.stats(); }
     
 signals:
-    void aircraftUpdated(const QMap<QString, Aircraft>& aircraft);
+    void aircraftUpdated(const AircraftSnapshot& aircraft);
+    void aircraftChanged(const AircraftDelta& delta);   // Same update, only what moved
+    void errorCorrectionUpdated(quint64 corrected, quint64 failed);
     void error(const QString& message);
+    void replayFinished();
     
 private slots:
     void fetchData();
-    void handleNetworkReply(QNetworkReply* reply);
+    void handlePolledData(const QByteArray& data);
+    void handleStreamData();
+    void handleStreamError(QAbstractSocket::SocketError socketError);
+    void handleReplayPayload(int kind, qint64 timeNs, const QByteArray& data);
+    void publishAircraft();
     
 private:
     QNetworkAccessManager* m_networkManager;
-    QTimer* m_updateTimer;
+    HttpPoller* m_poller;           // OpenSky and dump1090 aircraft.json
+    QTimer* m_updateTimer;          // Simulation ticks, stream expiry and reconnects
     Source m_source;
-    QMap<QString, Aircraft> m_aircraft;
+    AircraftTable m_aircraft;                   // Working copy, owned by the client's thread
+    SnapshotStore<AircraftTable> m_snapshots;   // What readers see
+    bool m_snapshotsEnabled;
+    TimingWheel m_expiry;                       // Staleness deadline per address
+    
+    // Streaming sources
+    QTcpSocket* m_socket;
+    QTimer* m_publishTimer;         // Coalesces stream updates into GUI-sized batches
+    QByteArray m_streamBuffer;
+    QString m_streamHost;
+    quint16 m_streamPort;           // 0 = default port for the source
+    Beast::Parser m_beastParser;
+    ModeS::ErrorCorrector m_errorCorrector;
+    
+    // Changes since the last emission; nothing is emitted while it is empty
+    PendingDelta m_pending;
+    
+    // Recording and replay
+    FeedRecording::Writer m_recorder;
+    QString m_recordPath;
+    FeedReplay* m_replay;
+    QString m_replayPath;
+    Source m_replayFormat;          // Source the replayed recording was made from
+    int64_t m_replayEpochNs;        // MonotonicClock time of recording time zero
+    int64_t m_replayNowNs;          // Replay clock: recording time reached, on the epoch
+    
+    // Simulation
+    TrafficSimulator m_simulator;
+    bool m_simulateStream;          // SBS-1 lines through the stream parser
+    std::string m_simulatorOutput;
     
     double m_userLat;
     double m_userLon;
@@ -58,8 +167,44 @@ private:
     
     void parseOpenSkyData(const QByteArray& data);
     void parseDump1090Data(const QByteArray& data);
-    void generateSimulatedData();
+    void simulateTraffic();
     void removeStaleAircraft();
+    
+    // Time of the message being applied: recording time during a replay, so
+    // CPR pairing and expiry come out the same at any replay speed
+    int64_t clockNs() const {
+        return m_source == REPLAY ? m_replayNowNs : MonotonicClock::nowNs();
+    }
+    void advanceReplayClock(int64_t recordingNs);
+    
+    // Format of the payloads: the source itself, or the one a replay was recorded from
+    Source feedFormat() const {
+        if (m_source == REPLAY) return m_replayFormat;
+        if (m_source == SIMULATED && m_simulateStream) return SBS_TCP;
+        return m_source;
+    }
+    static bool isStreamFormat(Source format) {
+        return format == BEAST_TCP || format == SBS_TCP || format == AVR_TCP;
+    }
+    static bool isPolledFormat(Source format) {
+        return format == OPENSKY_NETWORK || format == DUMP1090_LOCAL;
+    }
+    bool isStreamSource() const { return isStreamFormat(m_source); }
+    bool isPolledSource() const { return isPolledFormat(m_source); }
+    bool startReplay();
+    void record(FeedRecording::Kind kind, const QByteArray& data);
+    QNetworkRequest pollRequest() const;
+    void connectStream();
+    Aircraft& aircraftFor(uint32_t icao);
+    void markChanged(uint32_t icao, uint32_t fields);
+    void scheduleExpiry(const Aircraft& ac);
+    void removeAircraft(uint32_t icao);
+    void forgetAircraft(uint32_t icao);
+    void clearAircraft();
+    void handleBeastFrame(const Beast::Frame& frame);
+    void applyModeSMessage(const ModeS::Message& msg);
+    void applySbsMessage(const Sbs::Message& msg);
+    void applyCprPosition(Aircraft& ac, const ModeS::Message& msg);
 };
 
 #endif // ADSBCLIENT_H
@@ -1,19 +1,87 @@
 #include "aircraft.h"
 #include "geoutils.h"
+#include <cstring>
 
-Aircraft::Aircraft(const QString& icao, const QString& callsign,
+Aircraft::Aircraft(uint32_t icao, const QString& callsign,
                    double lat, double lon, double altitude,
                    double velocity, double heading)
-    : m_icao(icao), m_callsign(callsign),
+    : m_icao(icao),
       m_latitude(lat), m_longitude(lon), m_altitude(altitude),
       m_velocity(velocity), m_heading(heading), m_verticalRate(0.0),
-      m_lastUpdate(QDateTime::currentDateTime())
+      m_hasPosition(true),
+      m_lastSeenNs(MonotonicClock::nowNs()),
+      m_positionNs(m_lastSeenNs)
 {
+    setCallsign(callsign);
 }
 
-bool Aircraft::isStale() const {
-    // Consider data stale if not updated in last 30 seconds
-    return m_lastUpdate.secsTo(QDateTime::currentDateTime()) > 30;
+Aircraft::Aircraft(uint32_t icao)
+    : m_icao(icao),
+      m_lastSeenNs(MonotonicClock::nowNs())
+{
+}
+
+bool Aircraft::parseAddress(const QString& hex, uint32_t& address) {
+    int i = 0;
+    uint32_t flags = 0;
+    if (hex.startsWith(QLatin1Char('~'))) {
+        flags = NON_ICAO_FLAG;
+        i = 1;
+    }
+    if (hex.size() - i != 6) return false;
+    
+    uint32_t value = 0;
+    for (; i < hex.size(); ++i) {
+        ushort c = hex.at(i).unicode();
+        uint32_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        value = (value << 4) | digit;
+    }
+    
+    address = value | flags;
+    return true;
+}
+
+QString Aircraft::formatAddress(uint32_t address) {
+    QString hex = QString("%1").arg(address & 0xFFFFFF, 6, 16, QChar('0'));
+    return (address & NON_ICAO_FLAG) ? QLatin1Char('~') + hex : hex;
+}
+
+void Aircraft::setCallsign(const char* callsign) {
+    std::strncpy(m_callsign, callsign, sizeof(m_callsign) - 1);
+    m_callsign[sizeof(m_callsign) - 1] = '\0';
+}
+
+uint32_t Aircraft::changedFields(const Aircraft& before) const {
+    uint32_t fields = 0;
+    if (std::strcmp(m_callsign, before.m_callsign) != 0) fields |= CALLSIGN;
+    if (m_hasPosition != before.m_hasPosition ||
+        m_latitude != before.m_latitude ||
+        m_longitude != before.m_longitude) fields |= POSITION;
+    if (m_altitude != before.m_altitude) fields |= ALTITUDE;
+    if (m_velocity != before.m_velocity) fields |= VELOCITY;
+    if (m_heading != before.m_heading) fields |= HEADING;
+    if (m_verticalRate != before.m_verticalRate) fields |= VERTICAL_RATE;
+    if (m_squawk != before.m_squawk) fields |= SQUAWK;
+    return fields;
+}
+
+void Aircraft::copyFields(const Aircraft& from, uint32_t fields) {
+    if (fields & CALLSIGN) std::memcpy(m_callsign, from.m_callsign, sizeof(m_callsign));
+    if (fields & POSITION) {
+        m_latitude = from.m_latitude;
+        m_longitude = from.m_longitude;
+        m_hasPosition = from.m_hasPosition;
+        m_positionNs = from.m_positionNs;
+    }
+    if (fields & ALTITUDE) m_altitude = from.m_altitude;
+    if (fields & VELOCITY) m_velocity = from.m_velocity;
+    if (fields & HEADING) m_heading = from.m_heading;
+    if (fields & VERTICAL_RATE) m_verticalRate = from.m_verticalRate;
+    if (fields & SQUAWK) m_squawk = from.m_squawk;
 }
 
 double Aircraft::distanceTo(double lat, double lon) const {
@@ -2,54 +2,103 @@
 #define AIRCRAFT_H
 
 #include <QString>
-#include <QDateTime>
+#include <cstdint>
+#include "cpr.h"
+#include "monotonicclock.h"
 
 class Aircraft {
 public:
+    static constexpr int STALE_SECONDS = 30;    // Entries not heard from for longer are expired
+    static constexpr int64_t STALE_NS = STALE_SECONDS * MonotonicClock::NS_PER_SEC;
+    static constexpr uint32_t NO_ADDRESS = 0xFFFFFFFF;
+    static constexpr uint32_t NON_ICAO_FLAG = 0x1000000; // dump1090 "~" addresses (TIS-B, anonymous)
+    
+    // Reported fields, as bits of a change mask
+    enum Field {
+        CALLSIGN      = 1 << 0,
+        POSITION      = 1 << 1,
+        ALTITUDE      = 1 << 2,
+        VELOCITY      = 1 << 3,
+        HEADING       = 1 << 4,
+        VERTICAL_RATE = 1 << 5,
+        SQUAWK        = 1 << 6,
+        ALL_FIELDS    = (1 << 7) - 1
+    };
+    
     Aircraft() = default;
-    Aircraft(const QString& icao, const QString& callsign, 
+    explicit Aircraft(uint32_t icao);  // Known address, no position yet
+    Aircraft(uint32_t icao, const QString& callsign, 
              double lat, double lon, double altitude, 
              double velocity, double heading);
     
+    // 24-bit address <-> hex text ("4840d6", "~" prefix for NON_ICAO_FLAG)
+    static bool parseAddress(const QString& hex, uint32_t& address);
+    static QString formatAddress(uint32_t address);
+    
     // Getters
-    QString getICAO() const { return m_icao; }
-    QString getCallsign() const { return m_callsign; }
+    uint32_t getAddress() const { return m_icao; }
+    QString getICAO() const { return formatAddress(m_icao); }   // Display only
+    QString getCallsign() const { return QString::fromLatin1(m_callsign); }
     double getLatitude() const { return m_latitude; }
     double getLongitude() const { return m_longitude; }
     double getAltitude() const { return m_altitude; }
     double getVelocity() const { return m_velocity; }
     double getHeading() const { return m_heading; }
     double getVerticalRate() const { return m_verticalRate; }
-    QDateTime getLastUpdate() const { return m_lastUpdate; }
+    int getSquawk() const { return m_squawk; }
+    int64_t getLastSeen() const { return m_lastSeenNs; }    // MonotonicClock ns
+    int64_t getPositionTime() const { return m_positionNs; }  // MonotonicClock ns of the position fix
+    bool hasPosition() const { return m_hasPosition; }
     
     // Setters
-    void setCallsign(const QString& callsign) { m_callsign = callsign; }
-    void setPosition(double lat, double lon) { 
-        m_latitude = lat; 
+    void setCallsign(const QString& callsign) { setCallsign(callsign.toLatin1().constData()); }
+    void setCallsign(const char* callsign);     // Truncated to 8 characters
+    void setPosition(double lat, double lon, int64_t timeNs) {
+        m_latitude = lat;
         m_longitude = lon;
-        m_lastUpdate = QDateTime::currentDateTime();
+        m_hasPosition = true;
+        m_positionNs = timeNs;
     }
     void setAltitude(double altitude) { m_altitude = altitude; }
     void setVelocity(double velocity) { m_velocity = velocity; }
     void setHeading(double heading) { m_heading = heading; }
     void setVerticalRate(double rate) { m_verticalRate = rate; }
+    void setSquawk(int squawk) { m_squawk = squawk; }
+    void setLastSeen(int64_t nowNs) { m_lastSeenNs = nowNs; }
+    void markSeen() { m_lastSeenNs = MonotonicClock::nowNs(); }
+    
+    // Field bits that differ from an earlier copy (timestamps and CPR state are ignored)
+    uint32_t changedFields(const Aircraft& before) const;
+    
+    // Take the given field bits from another record (the position brings its
+    // fix time; the other timestamps and CPR state are kept)
+    void copyFields(const Aircraft& from, uint32_t fields);
+    
+    // Even/odd CPR frames awaiting a global position decode
+    CPR::FrameState& cprState() { return m_cpr; }
+    const CPR::FrameState& cprState() const { return m_cpr; }
     
     // Check if data is stale (not updated recently)
-    bool isStale() const;
+    bool isStale(int64_t nowNs) const { return nowNs - m_lastSeenNs > STALE_NS; }
+    bool isStale() const { return isStale(MonotonicClock::nowNs()); }
     
     // Calculate distance to another position
     double distanceTo(double lat, double lon) const;
     
 private:
-    QString m_icao;             // ICAO 24-bit address (unique identifier)
-    QString m_callsign;         // Flight callsign
-    double m_latitude;          // degrees
-    double m_longitude;         // degrees
-    double m_altitude;          // meters
-    double m_velocity;          // m/s
-    double m_heading;           // degrees (0-360)
-    double m_verticalRate;      // m/s (climb/descent rate)
-    QDateTime m_lastUpdate;
+    uint32_t m_icao = NO_ADDRESS; // ICAO 24-bit address (unique identifier)
+    char m_callsign[9] = {};    // Flight callsign, NUL-terminated
+    double m_latitude = 0.0;    // degrees
+    double m_longitude = 0.0;   // degrees
+    double m_altitude = 0.0;    // meters
+    double m_velocity = 0.0;    // m/s
+    double m_heading = 0.0;     // degrees (0-360)
+    double m_verticalRate = 0.0; // m/s (climb/descent rate)
+    int m_squawk = -1;          // Mode A code as written (e.g. 7700), -1 = unknown
+    bool m_hasPosition = false; // Stream sources learn the address before the position
+    CPR::FrameState m_cpr;
+    int64_t m_lastSeenNs = 0;   // MonotonicClock time of the last message
+    int64_t m_positionNs = 0;   // MonotonicClock time of the last position fix
 };
 
 #endif // AIRCRAFT_H
@@ -0,0 +1,128 @@
+#ifndef AIRCRAFTDELTA_H
+#define AIRCRAFTDELTA_H
+
+#include <QMetaType>
+#include <QVector>
+#include <QSet>
+#include <QHash>
+#include <cstdint>
+#include <utility>
+#include "aircraft.h"
+#include "aircrafttable.h"
+
+/**
+ * Changes to the aircraft table since the previous emission
+ *
+ * Records are carried by value so the delta can be applied on another
+ * thread. Added and changed records both replace whatever the receiver
+ * holds for that address; the mask only says which fields moved. The
+ * snapshot is the whole table as of this delta; it is null from a client
+ * that does not publish snapshots (ADSBClient::setSnapshotsEnabled()).
+ */
+struct AircraftDelta {
+    struct Change {
+        Aircraft aircraft;
+        uint32_t fields = 0;    // Aircraft::Field bits
+    };
+
+    QVector<Aircraft> added;
+    QVector<Change> changed;
+    QVector<uint32_t> removed;
+
+    AircraftSnapshot snapshot;
+    uint64_t version = 0;
+
+    bool isEmpty() const { return added.isEmpty() && changed.isEmpty() && removed.isEmpty(); }
+};
+
+/**
+ * Changes accumulated against a working table between two emissions
+ *
+ * Only addresses are tracked; records are read from the table when the
+ * delta is taken, so each aircraft is copied once however often it moved.
+ * Addresses whose records changed at all, timestamps and CPR state
+ * included, are also kept for the last two emissions, so a snapshot from
+ * before the previous emission can be brought up to date by catchUp().
+ */
+class PendingDelta {
+public:
+    bool isEmpty() const { return m_added.isEmpty() && m_changed.isEmpty() && m_removed.isEmpty(); }
+
+    // A record was created for icao
+    void insert(uint32_t icao) {
+        m_touched.insert(icao);
+
+        // Receivers still hold the record if it was removed since the last emission
+        if (m_removed.remove(icao)) {
+            m_changed[icao] = Aircraft::ALL_FIELDS;
+        } else {
+            m_added.insert(icao);
+        }
+    }
+
+    void change(uint32_t icao, uint32_t fields) {
+        m_touched.insert(icao);
+        if (fields == 0 || m_added.contains(icao)) return;
+        m_changed[icao] |= fields;
+    }
+
+    void remove(uint32_t icao) {
+        m_touched.insert(icao);
+        m_changed.remove(icao);
+
+        // An entry added and removed between two emissions was never published
+        if (!m_added.remove(icao)) {
+            m_removed.insert(icao);
+        }
+    }
+
+    // Fill delta's record lists from table and start over
+    void take(const AircraftTable& table, AircraftDelta& delta) {
+        delta.added.reserve(m_added.size());
+        for (uint32_t icao : std::as_const(m_added)) {
+            if (const Aircraft* ac = table.find(icao)) delta.added.append(*ac);
+        }
+        delta.changed.reserve(m_changed.size());
+        for (auto it = m_changed.cbegin(); it != m_changed.cend(); ++it) {
+            if (const Aircraft* ac = table.find(it.key())) delta.changed.append({*ac, it.value()});
+        }
+        delta.removed = QVector<uint32_t>(m_removed.cbegin(), m_removed.cend());
+
+        m_added.clear();
+        m_changed.clear();
+        m_removed.clear();
+        m_touchedBefore.swap(m_touched);
+        m_touched.clear();
+    }
+
+    /**
+     * Make older, the table as of the emission before the last one, equal to
+     * table, by copying or removing only the records touched since
+     *
+     * For SnapshotStore::publish(); call it before take().
+     */
+    void catchUp(const AircraftTable& table, AircraftTable& older) const {
+        auto copy = [&](uint32_t icao) {
+            if (const Aircraft* ac = table.find(icao)) {
+                older.upsert(icao) = *ac;
+            } else {
+                older.remove(icao);
+            }
+        };
+        for (uint32_t icao : m_touched) copy(icao);
+        for (uint32_t icao : m_touchedBefore) {
+            if (!m_touched.contains(icao)) copy(icao);
+        }
+    }
+
+private:
+    QSet<uint32_t> m_added;
+    QHash<uint32_t, uint32_t> m_changed;    // Address -> Aircraft::Field bits
+    QSet<uint32_t> m_removed;
+    QSet<uint32_t> m_touched;           // Since the last emission
+    QSet<uint32_t> m_touchedBefore;     // Between the two emissions before that
+};
+
+Q_DECLARE_METATYPE(AircraftDelta)
+
+#endif // AIRCRAFTDELTA_H
@@ -0,0 +1,333 @@
+#include "aircraftfusion.h"
+#include <QDateTime>
+#include <QDir>
+#include <algorithm>
+#include <utility>
+
+AircraftFusion::AircraftFusion(QObject* parent)
+    : QObject(parent),
+      m_publishTimer(new QTimer(this)),
+      m_running(false),
+      m_userLat(0.0),
+      m_userLon(0.0),
+      m_searchRadius(100000.0),  // Same default as ADSBClient
+      m_simulateStream(false)
+{
+    // Feeds polled on the same tick land in one emission
+    m_publishTimer->setSingleShot(true);
+    m_publishTimer->setInterval(250);
+    connect(m_publishTimer, &QTimer::timeout, this, &AircraftFusion::publishAircraft);
+}
+
+int AircraftFusion::defaultPriority(ADSBClient::Source source) {
+    switch (source) {
+        case ADSBClient::BEAST_TCP:
+        case ADSBClient::AVR_TCP:
+            return 0;
+        case ADSBClient::SBS_TCP:
+        case ADSBClient::DUMP1090_LOCAL:
+        case ADSBClient::REPLAY:
+            return 1;
+        case ADSBClient::OPENSKY_NETWORK:
+            return 2;
+        case ADSBClient::SIMULATED:
+        default:
+            return 3;
+    }
+}
+
+int AircraftFusion::feedIndex(const QString& name) const {
+    for (size_t i = 0; i < m_feeds.size(); ++i) {
+        if (m_feeds[i].client && m_feeds[i].stats.name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+ADSBClient* AircraftFusion::feed(const QString& name) const {
+    int i = feedIndex(name);
+    return i < 0 ? nullptr : m_feeds[i].client;
+}
+
+int AircraftFusion::feedCount() const {
+    return static_cast<int>(std::count_if(m_feeds.begin(), m_feeds.end(),
+                                          [](const Feed& f) { return f.client != nullptr; }));
+}
+
+bool AircraftFusion::addFeed(const QString& name, ADSBClient::Source source, int priority) {
+    if (feedIndex(name) >= 0) return false;
+
+    ADSBClient* client = new ADSBClient(this);
+    client->setSource(source);
+    if (source == ADSBClient::SIMULATED) {
+        client->setSimulation(m_simulation, m_simulateStream);
+    }
+    if (!m_recordDir.isEmpty()) {
+        QString stamp = QDateTime::currentDateTimeUtc().toString("yyyyMMdd-HHmmss");
+        client->setRecordFile(QDir(m_recordDir).filePath(QString("%1-%2.rec").arg(name, stamp)));
+    }
+    return addClient(name, client, priority >= 0 ? priority : defaultPriority(source));
+}
+
+bool AircraftFusion::addReplayFeed(const QString& name, const QString& path, double speed, int priority) {
+    if (feedIndex(name) >= 0) return false;
+
+    ADSBClient* client = new ADSBClient(this);
+    client->setSource(ADSBClient::REPLAY);
+    client->setReplayFile(path, speed);
+    return addClient(name, client, priority >= 0 ? priority : defaultPriority(ADSBClient::REPLAY));
+}
+
+bool AircraftFusion::addClient(const QString& name, ADSBClient* client, int priority) {
+    // Reuse a free slot; its bit is clear in every Arbitration
+    int index = -1;
+    for (size_t i = 0; i < m_feeds.size(); ++i) {
+        if (!m_feeds[i].client) {
+            index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (index < 0) {
+        if (static_cast<int>(m_feeds.size()) >= MAX_FEEDS) {
+            delete client;
+            return false;
+        }
+        index = static_cast<int>(m_feeds.size());
+        m_feeds.emplace_back();
+    }
+
+    client->setUserLocation(m_userLat, m_userLon);
+    client->setSearchRadius(m_searchRadius);
+    client->setSnapshotsEnabled(false);     // Merged from its deltas; only the fusion publishes
+
+    Feed& feed = m_feeds[index];
+    feed = Feed();
+    feed.client = client;
+    feed.stats.name = name;
+    feed.stats.priority = priority;
+
+    connect(client, &ADSBClient::aircraftChanged, this, [this, index](const AircraftDelta& delta) {
+        applyFeedDelta(index, delta);
+    });
+    connect(client, &ADSBClient::errorCorrectionUpdated, this,
+            [this, index](quint64 corrected, quint64 failed) {
+        updateErrorCorrection(index, corrected, failed);
+    });
+    connect(client, &ADSBClient::error, this, [this, name](const QString& message) {
+        emit error(QString("%1: %2").arg(name, message));
+    });
+
+    if (m_running) client->start();
+    return true;
+}
+
+void AircraftFusion::removeFeed(const QString& name) {
+    int index = feedIndex(name);
+    if (index < 0) return;
+
+    // Stopping publishes the removal of everything the feed reported
+    ADSBClient* client = m_feeds[index].client;
+    client->stop();
+    disconnect(client, nullptr, this, nullptr);
+    client->deleteLater();
+
+    // Nothing should be left, but the slot bit must be clear before reuse
+    uint32_t bit = 1u << index;
+    QVector<uint32_t> orphans;
+    for (auto it = m_arbitration.cbegin(); it != m_arbitration.cend(); ++it) {
+        if (it.value().feeds & bit) orphans.append(it.key());
+    }
+    for (uint32_t icao : std::as_const(orphans)) {
+        dropFeedAircraft(index, icao);
+    }
+    schedulePublish();
+
+    updateErrorCorrection(index, 0, 0);
+    m_feeds[index] = Feed();
+}
+
+void AircraftFusion::setUserLocation(double lat, double lon) {
+    m_userLat = lat;
+    m_userLon = lon;
+    for (const Feed& feed : m_feeds) {
+        if (feed.client) feed.client->setUserLocation(lat, lon);
+    }
+}
+
+void AircraftFusion::setSearchRadius(double meters) {
+    m_searchRadius = meters;
+    for (const Feed& feed : m_feeds) {
+        if (feed.client) feed.client->setSearchRadius(meters);
+    }
+}
+
+void AircraftFusion::setSimulation(const TrafficSimulator::Config& config, bool rawStream) {
+    m_simulation = config;
+    m_simulateStream = rawStream;
+}
+
+void AircraftFusion::start() {
+    m_running = true;
+    for (const Feed& feed : m_feeds) {
+        if (feed.client) feed.client->start();
+    }
+}
+
+void AircraftFusion::stop() {
+    m_running = false;
+    for (const Feed& feed : m_feeds) {
+        if (feed.client) feed.client->stop();
+    }
+    publishAircraft();
+}
+
+void AircraftFusion::applyFeedDelta(int feed, const AircraftDelta& delta) {
+    for (const Aircraft& ac : delta.added) {
+        applyFeedAircraft(feed, ac, Aircraft::ALL_FIELDS, true);
+    }
+    for (const AircraftDelta::Change& change : delta.changed) {
+        applyFeedAircraft(feed, change.aircraft, change.fields, false);
+    }
+    for (uint32_t icao : delta.removed) {
+        dropFeedAircraft(feed, icao);
+    }
+
+    schedulePublish();
+}
+
+void AircraftFusion::schedulePublish() {
+    if (!m_pending.isEmpty() && !m_publishTimer->isActive()) {
+        m_publishTimer->start();
+    }
+}
+
+void AircraftFusion::applyFeedAircraft(int feed, const Aircraft& report, uint32_t fields, bool added) {
+    FeedStats& stats = m_feeds[feed].stats;
+    ++stats.updates;
+
+    uint32_t icao = report.getAddress();
+    int64_t seen = report.getLastSeen();
+    bool inserted;
+    Aircraft& ac = m_aircraft.upsert(icao, &inserted);
+    Arbitration& arb = m_arbitration[icao];
+
+    uint32_t bit = 1u << feed;
+    if (!(arb.feeds & bit)) {
+        arb.feeds |= bit;
+        ++stats.aircraft;
+    }
+
+    if (inserted) {
+        // First feed to report the aircraft supplies everything
+        ac = report;
+        arb.seenNs = seen;
+        if (report.hasPosition()) {
+            arb.positionFeed = feed;
+            arb.positionNs = report.getPositionTime();
+            ++stats.positionsUsed;
+        }
+        m_pending.insert(icao);
+        return;
+    }
+
+    if (added) {
+        // A feed that just picked the aircraft up has not necessarily heard every
+        // field; only take what is known to be set
+        fields = 0;
+        if (report.hasPosition()) fields |= Aircraft::POSITION;
+        if (!report.getCallsign().isEmpty()) fields |= Aircraft::CALLSIGN;
+        if (report.getSquawk() >= 0) fields |= Aircraft::SQUAWK;
+    }
+
+    const Aircraft before = ac;
+    uint32_t take = 0;
+
+    uint32_t other = fields & ~static_cast<uint32_t>(Aircraft::POSITION);
+    if (other && (feed == arb.positionFeed || seen >= arb.seenNs)) {
+        take |= other;
+    }
+    if ((fields & Aircraft::POSITION) && report.hasPosition() &&
+        takePosition(feed, report.getPositionTime(), arb)) {
+        take |= Aircraft::POSITION;
+    }
+
+    if (take) {
+        ac.copyFields(report, take);
+        arb.seenNs = std::max(arb.seenNs, seen);
+        ac.setLastSeen(arb.seenNs);
+    }
+
+    // Identical values relayed by several feeds produce no change
+    m_pending.change(icao, ac.changedFields(before));
+}
+
+bool AircraftFusion::takePosition(int feed, int64_t positionNs, Arbitration& arb) {
+    FeedStats& stats = m_feeds[feed].stats;
+
+    if (arb.positionFeed >= 0 && arb.positionFeed != feed) {
+        if (positionNs <= arb.positionNs) {
+            ++stats.duplicates;
+            return false;
+        }
+        const FeedStats& holder = m_feeds[arb.positionFeed].stats;
+        if (stats.priority > holder.priority && positionNs - arb.positionNs < POSITION_HOLD_NS) {
+            ++stats.positionsOutranked;
+            return false;
+        }
+    }
+
+    arb.positionFeed = feed;
+    arb.positionNs = positionNs;
+    ++stats.positionsUsed;
+    return true;
+}
+
+void AircraftFusion::dropFeedAircraft(int feed, uint32_t icao) {
+    auto it = m_arbitration.find(icao);
+    uint32_t bit = 1u << feed;
+    if (it == m_arbitration.end() || !(it->feeds & bit)) return;
+
+    it->feeds &= ~bit;
+    --m_feeds[feed].stats.aircraft;
+
+    // The position stays until another feed has a newer fix
+    if (it->positionFeed == feed) it->positionFeed = -1;
+
+    if (it->feeds == 0) {
+        m_arbitration.erase(it);
+        m_aircraft.remove(icao);
+        m_pending.remove(icao);
+    }
+}
+
+void AircraftFusion::updateErrorCorrection(int feed, quint64 corrected, quint64 failed) {
+    m_feeds[feed].fecCorrected = corrected;
+    m_feeds[feed].fecFailed = failed;
+
+    quint64 totalCorrected = 0;
+    quint64 totalFailed = 0;
+    for (const Feed& f : m_feeds) {
+        totalCorrected += f.fecCorrected;
+        totalFailed += f.fecFailed;
+    }
+    emit errorCorrectionUpdated(totalCorrected, totalFailed);
+}
+
+void AircraftFusion::publishAircraft() {
+    if (m_pending.isEmpty()) return;
+
+    AircraftDelta delta;
+    delta.version = m_snapshots.publish(m_aircraft, [this](AircraftTable& older) {
+        m_pending.catchUp(m_aircraft, older);
+    });
+    m_pending.take(m_aircraft, delta);
+    delta.snapshot = m_snapshots.current();
+
+    QVector<FeedStats> stats;
+    for (const Feed& feed : m_feeds) {
+        if (feed.client) stats.append(feed.stats);
+    }
+    m_stats.publish(std::move(stats));
+
+    emit aircraftChanged(delta);
+    emit aircraftUpdated(delta.snapshot);
+}
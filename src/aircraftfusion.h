@@ -0,0 +1,146 @@
+#ifndef AIRCRAFTFUSION_H
+#define AIRCRAFTFUSION_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+#include <memory>
+#include <vector>
+#include "aircraft.h"
+#include "aircrafttable.h"
+#include "aircraftdelta.h"
+#include "snapshotstore.h"
+#include "adsbclient.h"
+
+/**
+ * Several ADS-B feeds merged into one aircraft table
+ *
+ * Each feed is an ADSBClient of its own (a local dump1090 next to a network
+ * aggregator, say) owned by the fusion and running on its thread. Feeds are
+ * merged from their deltas, so the cost per second is proportional to what
+ * the feeds report, not to the size of the fleet.
+ *
+ * Per aircraft, the position comes from one feed at a time. Fixes are
+ * compared by their own fix time (Aircraft::getPositionTime()), which other
+ * messages do not refresh. A fix that is not newer than the one shown is a
+ * duplicate (aggregators relay the same
+ * messages later) and is dropped. A newer fix from a feed of the same or
+ * better quality takes over; a lower-quality feed only takes over once the
+ * current one has been silent for POSITION_HOLD_NS. Other fields come from
+ * the position feed or from any feed with newer data. An aircraft is
+ * removed once no feed reports it any more.
+ *
+ * The signals and getAircraft() mirror ADSBClient, so views do not care
+ * whether they are connected to one feed or to the fusion.
+ */
+class AircraftFusion : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_FEEDS = 32;    // One bit each in the per-aircraft feed mask
+    static constexpr int64_t POSITION_HOLD_NS = 5 * MonotonicClock::NS_PER_SEC;
+
+    struct FeedStats {
+        QString name;
+        int priority = 0;
+        int aircraft = 0;               // Addresses the feed currently reports
+        quint64 updates = 0;            // Aircraft records received
+        quint64 positionsUsed = 0;      // Fixes that won arbitration
+        quint64 positionsOutranked = 0; // Newer fixes held back for a better feed
+        quint64 duplicates = 0;         // Fixes no newer than the one shown
+    };
+
+    explicit AircraftFusion(QObject* parent = nullptr);
+    ~AircraftFusion() override = default;
+
+    /**
+     * Start merging a new feed
+     *
+     * @param name     Unique label, used in statistics and errors
+     * @param priority Lower is better; -1 takes defaultPriority(source)
+     * @return false if the name is taken or MAX_FEEDS are running
+     */
+    bool addFeed(const QString& name, ADSBClient::Source source, int priority = -1);
+
+    // Feed playing a recording made with setRecordDirectory(); speed as in FeedReplay
+    bool addReplayFeed(const QString& name, const QString& path, double speed = 1.0, int priority = -1);
+    void removeFeed(const QString& name);
+
+    // The client behind a feed, for per-feed settings such as the stream endpoint
+    ADSBClient* feed(const QString& name) const;
+    int feedCount() const;
+
+    // Raw frames decoded locally beat relayed positions, which beat simulation
+    static int defaultPriority(ADSBClient::Source source);
+
+    void setUserLocation(double lat, double lon);
+    void setSearchRadius(double meters);
+
+    // Feeds added from now on record to <dir>/<name>-<UTC time>.rec; empty disables
+    void setRecordDirectory(const QString& dir) { m_recordDir = dir; }
+
+    // Traffic of SIMULATED feeds added from now on, see ADSBClient::setSimulation()
+    void setSimulation(const TrafficSimulator::Config& config, bool rawStream = false);
+
+    void start();
+    void stop();
+
+    // Last published merge and feed statistics; safe to call from any thread
+    AircraftSnapshot getAircraft() const { return m_snapshots.current(); }
+    uint64_t aircraftVersion() const { return m_snapshots.version(); }
+    std::shared_ptr<const QVector<FeedStats>> getFeedStats() const { return m_stats.current(); }
+
+signals:
+    void aircraftUpdated(const AircraftSnapshot& aircraft);
+    void aircraftChanged(const AircraftDelta& delta);
+    void errorCorrectionUpdated(quint64 corrected, quint64 failed);     // Summed over feeds
+    void error(const QString& message);
+
+private slots:
+    void publishAircraft();
+
+private:
+    // Which feeds report an aircraft and which one supplies its position
+    struct Arbitration {
+        uint32_t feeds = 0;         // Bit per feed slot
+        int positionFeed = -1;      // -1 = the next fix from any feed is taken
+        int64_t positionNs = 0;     // Fix time of the position shown
+        int64_t seenNs = 0;         // Newest data taken from any feed
+    };
+
+    struct Feed {
+        ADSBClient* client = nullptr;   // nullptr = free slot
+        FeedStats stats;
+        quint64 fecCorrected = 0;
+        quint64 fecFailed = 0;
+    };
+
+    std::vector<Feed> m_feeds;          // Slot index = bit in Arbitration::feeds
+    AircraftTable m_aircraft;           // Merged working copy
+    QHash<uint32_t, Arbitration> m_arbitration;
+    PendingDelta m_pending;
+    SnapshotStore<AircraftTable> m_snapshots;
+    SnapshotStore<QVector<FeedStats>> m_stats;
+    QTimer* m_publishTimer;             // Coalesces feed deltas that arrive together
+
+    bool m_running;
+    double m_userLat;
+    double m_userLon;
+    double m_searchRadius;
+    QString m_recordDir;
+    TrafficSimulator::Config m_simulation;
+    bool m_simulateStream;
+
+    bool addClient(const QString& name, ADSBClient* client, int priority);
+    int feedIndex(const QString& name) const;
+    void applyFeedDelta(int feed, const AircraftDelta& delta);
+    void applyFeedAircraft(int feed, const Aircraft& report, uint32_t fields, bool added);
+    bool takePosition(int feed, int64_t positionNs, Arbitration& arb);
+    void dropFeedAircraft(int feed, uint32_t icao);
+    void updateErrorCorrection(int feed, quint64 corrected, quint64 failed);
+    void schedulePublish();
+};
+
+#endif // AIRCRAFTFUSION_H
@@ -0,0 +1,112 @@
+#include "aircrafttable.h"
+
+namespace {
+    constexpr uint32_t MIN_SLOTS = 16;
+}
+
+AircraftTable::AircraftTable()
+    : m_mask(0),
+      m_shift(32)
+{
+    rehash(MIN_SLOTS);
+}
+
+void AircraftTable::clear() {
+    m_records.clear();
+    for (Slot& slot : m_slots) {
+        slot.key = EMPTY;
+    }
+}
+
+void AircraftTable::reserve(int count) {
+    m_records.reserve(count);
+
+    uint32_t slots = MIN_SLOTS;
+    while (slots < static_cast<uint32_t>(count) * 2) slots <<= 1;
+    if (slots > m_slots.size()) {
+        rehash(slots);
+    }
+}
+
+uint32_t AircraftTable::findSlot(uint32_t icao) const {
+    uint32_t i = home(icao);
+    while (m_slots[i].key != icao && m_slots[i].key != EMPTY) {
+        i = (i + 1) & m_mask;
+    }
+    return i;
+}
+
+Aircraft* AircraftTable::find(uint32_t icao) {
+    const Slot& slot = m_slots[findSlot(icao)];
+    return slot.key == EMPTY ? nullptr : &m_records[slot.index];
+}
+
+const Aircraft* AircraftTable::find(uint32_t icao) const {
+    const Slot& slot = m_slots[findSlot(icao)];
+    return slot.key == EMPTY ? nullptr : &m_records[slot.index];
+}
+
+Aircraft& AircraftTable::upsert(uint32_t icao, bool* inserted) {
+    uint32_t i = findSlot(icao);
+    if (m_slots[i].key != EMPTY) {
+        if (inserted) *inserted = false;
+        return m_records[m_slots[i].index];
+    }
+
+    // Keep the load factor at or below 1/2
+    if ((m_records.size() + 1) * 2 > m_slots.size()) {
+        rehash(static_cast<uint32_t>(m_slots.size()) * 2);
+        i = findSlot(icao);
+    }
+
+    m_slots[i].key = icao;
+    m_slots[i].index = static_cast<uint32_t>(m_records.size());
+    m_records.emplace_back(icao);
+
+    if (inserted) *inserted = true;
+    return m_records.back();
+}
+
+bool AircraftTable::remove(uint32_t icao) {
+    uint32_t hole = findSlot(icao);
+    if (m_slots[hole].key == EMPTY) return false;
+
+    // Fill the record gap with the last record and repoint its slot
+    uint32_t index = m_slots[hole].index;
+    uint32_t last = static_cast<uint32_t>(m_records.size()) - 1;
+    if (index != last) {
+        m_records[index] = std::move(m_records[last]);
+        m_slots[findSlot(m_records[index].getAddress())].index = index;
+    }
+    m_records.pop_back();
+
+    // Backward-shift deletion: pull later members of the probe run into the hole
+    // unless that would move them in front of their home slot
+    uint32_t i = hole;
+    for (;;) {
+        i = (i + 1) & m_mask;
+        if (m_slots[i].key == EMPTY) break;
+
+        uint32_t h = home(m_slots[i].key);
+        bool movable = (hole <= i) ? (h <= hole || h > i) : (h <= hole && h > i);
+        if (movable) {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole].key = EMPTY;
+    return true;
+}
+
+void AircraftTable::rehash(uint32_t slotCount) {
+    m_slots.assign(slotCount, Slot{EMPTY, 0});
+    m_mask = slotCount - 1;
+    m_shift = 32;
+    for (uint32_t n = slotCount; n > 1; n >>= 1) --m_shift;
+
+    for (uint32_t index = 0; index < m_records.size(); ++index) {
+        uint32_t i = findSlot(m_records[index].getAddress());
+        m_slots[i].key = m_records[index].getAddress();
+        m_slots[i].index = index;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef AIRCRAFTTABLE_H
+#define AIRCRAFTTABLE_H
+
+#include <QMetaType>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aircraft.h"
+
+/**
+ * Aircraft store keyed by 24-bit address
+ *
+ * Records live contiguously in a dense array, so iterating the fleet (paint,
+ * list, proximity) walks memory linearly. Lookups go through an
+ * open-addressing index with linear probing over 8-byte {address, record}
+ * slots, kept at most half full. Removal swaps the last record into the
+ * hole and uses backward-shift deletion in the index, so there are no
+ * tombstones and no rehashing after churn.
+ *
+ * Iteration order is unspecified. Pointers and references to records are
+ * invalidated by upsert() and remove().
+ */
+class AircraftTable {
+public:
+    using iterator = std::vector<Aircraft>::iterator;
+    using const_iterator = std::vector<Aircraft>::const_iterator;
+
+    AircraftTable();
+
+    int size() const { return static_cast<int>(m_records.size()); }
+    bool isEmpty() const { return m_records.empty(); }
+    void clear();
+    void reserve(int count);
+
+    Aircraft* find(uint32_t icao);
+    const Aircraft* find(uint32_t icao) const;
+    bool contains(uint32_t icao) const { return find(icao) != nullptr; }
+
+    // Record for icao, created as Aircraft(icao) if missing
+    Aircraft& upsert(uint32_t icao, bool* inserted = nullptr);
+
+    bool remove(uint32_t icao);
+
+    // Remove every record for which pred(const Aircraft&) returns true
+    template<typename Predicate>
+    int removeIf(Predicate pred) {
+        int removed = 0;
+        // Walking backwards means the record swapped into a hole was already checked
+        for (int i = size() - 1; i >= 0; --i) {
+            if (pred(static_cast<const Aircraft&>(m_records[i]))) {
+                remove(m_records[i].getAddress());
+                ++removed;
+            }
+        }
+        return removed;
+    }
+
+    iterator begin() { return m_records.begin(); }
+    iterator end() { return m_records.end(); }
+    const_iterator begin() const { return m_records.begin(); }
+    const_iterator end() const { return m_records.end(); }
+
+private:
+    static constexpr uint32_t EMPTY = Aircraft::NO_ADDRESS;
+
+    struct Slot {
+        uint32_t key;
+        uint32_t index;     // Into m_records
+    };
+
+    std::vector<Slot> m_slots;          // Power-of-two size
+    std::vector<Aircraft> m_records;
+    uint32_t m_mask;
+    int m_shift;
+
+    uint32_t home(uint32_t icao) const {
+        // Fibonacci hashing; addresses are handed out in sequential national blocks
+        return (icao * 2654435769u) >> m_shift;
+    }
+
+    uint32_t findSlot(uint32_t icao) const;
+    void rehash(uint32_t slotCount);
+};
+
+// Immutable published version of the table (see SnapshotStore)
+using AircraftSnapshot = std::shared_ptr<const AircraftTable>;
+
+Q_DECLARE_METATYPE(AircraftTable)
+Q_DECLARE_METATYPE(AircraftSnapshot)
+
+#endif // AIRCRAFTTABLE_H
@@ -0,0 +1,145 @@
+#ifndef BEASTPARSER_H
+#define BEASTPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Beast binary protocol framer (dump1090 / readsb port 30005)
+ *
+ * Frame layout:  0x1a <type> <6-byte MLAT timestamp> <signal> <message>
+ * Any 0x1a inside the frame body is sent twice. Types:
+ *   '1' Mode A/C (2 bytes), '2' Mode S short (7 bytes), '3' Mode S long (14 bytes)
+ *
+ * The parser works directly on the socket read buffer. Frames without escape
+ * sequences are handed out as pointers into that buffer; only frames that
+ * actually contain doubled 0x1a bytes are unescaped into a small scratch area.
+ */
+namespace Beast {
+    constexpr uint8_t ESCAPE = 0x1a;
+    constexpr int MAX_MESSAGE_BYTES = 14;
+
+    struct Frame {
+        char type;              // '1', '2' or '3'
+        uint64_t timestamp;     // 12 MHz MLAT counter
+        uint8_t signal;         // RSSI byte
+        const uint8_t* data;    // Message bytes (valid only during the callback)
+        int length;             // 2, 7 or 14
+    };
+
+    inline int messageLength(uint8_t type) {
+        switch (type) {
+            case '1': return 2;
+            case '2': return 7;
+            case '3': return 14;
+            default:  return -1;
+        }
+    }
+
+    class Parser {
+    public:
+        /**
+         * Scan [data, data + size) and call sink(const Frame&) for every complete frame.
+         *
+         * @return Number of bytes consumed. Bytes past that point belong to a
+         *         partial frame and must be kept for the next call.
+         */
+        template<typename Sink>
+        size_t parse(const uint8_t* data, size_t size, Sink&& sink);
+
+        uint64_t framesParsed() const { return m_framesParsed; }
+        uint64_t resyncs() const { return m_resyncs; }
+
+    private:
+        uint8_t m_scratch[7 + MAX_MESSAGE_BYTES];
+        uint64_t m_framesParsed = 0;
+        uint64_t m_resyncs = 0;
+        bool m_skipping = false;    // The last call ended inside junk
+    };
+
+    template<typename Sink>
+    size_t Parser::parse(const uint8_t* data, size_t size, Sink&& sink) {
+        size_t pos = 0;
+
+        while (pos < size) {
+            // Find the start of the next frame. A run of junk counts as one
+            // resync however the socket reads split it.
+            if (data[pos] != ESCAPE) {
+                if (!m_skipping) ++m_resyncs;
+                m_skipping = true;
+                const void* next = std::memchr(data + pos, ESCAPE, size - pos);
+                if (!next) return size;
+                pos = static_cast<const uint8_t*>(next) - data;
+            }
+            m_skipping = false;
+
+            if (pos + 1 >= size) return pos;
+
+            int msgLen = messageLength(data[pos + 1]);
+            if (msgLen < 0) {
+                // Not a frame we understand (status frame or doubled 0x1a); skip it
+                pos += (data[pos + 1] == ESCAPE) ? 2 : 1;
+                continue;
+            }
+
+            // Walk the body once: 6 timestamp + 1 signal + message bytes
+            const int bodyLen = 7 + msgLen;
+            size_t cursor = pos + 2;
+            int count = 0;
+            bool escaped = false;
+            bool broken = false;
+
+            while (count < bodyLen && cursor < size) {
+                if (data[cursor] == ESCAPE) {
+                    if (cursor + 1 >= size) break;
+                    if (data[cursor + 1] != ESCAPE) {
+                        broken = true; // Lone 0x1a marks the start of another frame
+                        break;
+                    }
+                    escaped = true;
+                    cursor += 2;
+                } else {
+                    ++cursor;
+                }
+                ++count;
+            }
+
+            if (broken) {
+                ++m_resyncs;
+                pos = cursor;
+                continue;
+            }
+            if (count < bodyLen) return pos; // Incomplete, wait for more data
+
+            const uint8_t* body = data + pos + 2;
+            if (escaped) {
+                size_t in = pos + 2;
+                for (int i = 0; i < bodyLen; ++i) {
+                    m_scratch[i] = data[in];
+                    in += (data[in] == ESCAPE) ? 2 : 1;
+                }
+                body = m_scratch;
+            }
+
+            Frame frame;
+            frame.type = static_cast<char>(data[pos + 1]);
+            frame.timestamp = 0;
+            for (int i = 0; i < 6; ++i) {
+                frame.timestamp = (frame.timestamp << 8) | body[i];
+            }
+            frame.signal = body[6];
+            frame.data = body + 7;
+            frame.length = msgLen;
+
+            ++m_framesParsed;
+            sink(frame);
+
+            pos = cursor;
+        }
+
+        return pos;
+    }
+}
+
+#endif // BEASTPARSER_H
@@ -0,0 +1,99 @@
+#include "cpr.h"
+#include <cmath>
+
+namespace {
+    inline double cprMod(double a, double b) {
+        double r = std::fmod(a, b);
+        return r < 0 ? r + b : r;
+    }
+
+    inline double wrapLongitude(double lon) {
+        while (lon >= 180.0) lon -= 360.0;
+        while (lon < -180.0) lon += 360.0;
+        return lon;
+    }
+
+    // Pick the k * period offset of value that lies closest to ref
+    inline double nearestCandidate(double value, double period, double ref) {
+        return value + period * std::floor((ref - value) / period + 0.5);
+    }
+}
+
+namespace CPR {
+
+bool decodeGlobal(const FrameState& state, double refLat, double refLon,
+                  double& lat, double& lon) {
+    const bool surface = state.surface[0];
+    const double span = surface ? 90.0 : 360.0;
+    const double dLat0 = span / 60.0;
+    const double dLat1 = span / 59.0;
+
+    const double latE = state.lat[0];
+    const double latO = state.lat[1];
+
+    double j = std::floor((59.0 * latE - 60.0 * latO) / SCALE + 0.5);
+    double rlat0 = dLat0 * (cprMod(j, 60.0) + latE / SCALE);
+    double rlat1 = dLat1 * (cprMod(j, 59.0) + latO / SCALE);
+
+    if (surface) {
+        // Northern and southern solutions are 90 degrees apart
+        rlat0 = nearestCandidate(rlat0, 90.0, refLat);
+        rlat1 = nearestCandidate(rlat1, 90.0, refLat);
+    } else {
+        if (rlat0 >= 270.0) rlat0 -= 360.0;
+        if (rlat1 >= 270.0) rlat1 -= 360.0;
+    }
+
+    if (rlat0 < -90.0 || rlat0 > 90.0 || rlat1 < -90.0 || rlat1 > 90.0) return false;
+
+    // Frames from different latitude zones cannot be combined
+    int nl = NL(rlat0);
+    if (nl != NL(rlat1)) return false;
+
+    const bool odd = state.oddIsNewer();
+    int ni = odd ? nl - 1 : nl;
+    if (ni < 1) ni = 1;
+
+    double m = std::floor((state.lon[0] * (nl - 1.0) - state.lon[1] * nl) / SCALE + 0.5);
+    double rlon = (span / ni) * (cprMod(m, ni) + state.lon[odd ? 1 : 0] / SCALE);
+
+    if (surface) {
+        rlon = nearestCandidate(rlon, 90.0, refLon);
+    }
+
+    lat = odd ? rlat1 : rlat0;
+    lon = wrapLongitude(rlon);
+    return true;
+}
+
+bool decodeLocal(int cprLat, int cprLon, bool odd, bool surface,
+                 double refLat, double refLon, double& lat, double& lon) {
+    const double span = surface ? 90.0 : 360.0;
+    const double dLat = span / (odd ? 59.0 : 60.0);
+    const double fracLat = cprLat / SCALE;
+
+    double j = std::floor(refLat / dLat) +
+               std::floor(0.5 + cprMod(refLat, dLat) / dLat - fracLat);
+    double rlat = dLat * (j + fracLat);
+
+    if (rlat < -90.0 || rlat > 90.0) return false;
+    if (std::fabs(rlat - refLat) > dLat / 2.0) return false;
+
+    int ni = NL(rlat) - (odd ? 1 : 0);
+    if (ni < 1) ni = 1;
+
+    const double dLon = span / ni;
+    const double fracLon = cprLon / SCALE;
+
+    double m = std::floor(refLon / dLon) +
+               std::floor(0.5 + cprMod(refLon, dLon) / dLon - fracLon);
+    double rlon = dLon * (m + fracLon);
+
+    if (std::fabs(wrapLongitude(rlon - refLon)) > dLon / 2.0) return false;
+
+    lat = rlat;
+    lon = wrapLongitude(rlon);
+    return true;
+}
+
+}
@@ -0,0 +1,118 @@
+#ifndef CPR_H
+#define CPR_H
+
+#include <cstdint>
+
+/**
+ * Compact Position Reporting (CPR) decoding for ADS-B position messages
+ *
+ * Airborne positions use 360 degree latitude zones, surface positions 90
+ * degree zones. A position is recovered either globally from one even and
+ * one odd frame, or locally from a single frame plus a reference position
+ * that is known to be within half a zone (the last fix, or the receiver).
+ */
+namespace CPR {
+    constexpr double SCALE = 131072.0;          // 2^17
+    constexpr int64_t AIRBORNE_PAIR_MS = 10000; // Max even/odd spacing (DO-260B)
+    constexpr int64_t SURFACE_PAIR_MS = 25000;
+
+    /**
+     * Latitudes at which the number of longitude zones drops by one
+     * (1090-WP-9-14, NZ = 15). Index i is the lower bound of NL = 58 - i;
+     * a latitude exactly on a transition already has the smaller count.
+     */
+    constexpr double NL_TRANSITIONS[] = {
+        10.47047130, 14.82817437, 18.18626357, 21.02939493, 23.54504487,
+        25.82924707, 27.93898710, 29.91135686, 31.77209708, 33.53993436,
+        35.22899598, 36.85025108, 38.41241892, 39.92256684, 41.38651832,
+        42.80914012, 44.19454951, 45.54626723, 46.86733252, 48.16039128,
+        49.42776439, 50.67150166, 51.89342469, 53.09516153, 54.27817472,
+        55.44378444, 56.59318756, 57.72747354, 58.84763776, 59.95459277,
+        61.04917774, 62.13216659, 63.20427479, 64.26616523, 65.31845310,
+        66.36171008, 67.39646774, 68.42322022, 69.44242631, 70.45451075,
+        71.45986473, 72.45884545, 73.45177442, 74.43893416, 75.42056257,
+        76.39684391, 77.36789461, 78.33374083, 79.29428225, 80.24923213,
+        81.19801349, 82.13956981, 83.07199445, 83.99173563, 84.89166191,
+        85.75541621, 86.53536998
+    };
+    constexpr int NL_TRANSITION_COUNT = sizeof(NL_TRANSITIONS) / sizeof(NL_TRANSITIONS[0]);
+
+    // A single zone strictly above this latitude; ±87° itself still has two
+    constexpr double NL_POLE_CAP = 87.0;
+
+    /**
+     * Number of longitude zones at a latitude (1..59)
+     *
+     * Binary search over the transition table; no trigonometry at run time.
+     */
+    constexpr int NL(double lat) {
+        if (lat < 0) lat = -lat;
+        if (lat > NL_POLE_CAP) return 1;
+        int lo = 0;
+        int hi = NL_TRANSITION_COUNT;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (NL_TRANSITIONS[mid] <= lat) lo = mid + 1;
+            else hi = mid;
+        }
+        return 59 - lo;
+    }
+
+    static_assert(NL(0.0) == 59, "NL at the equator");
+    static_assert(NL(-45.0) == 42, "NL is symmetric");
+    static_assert(NL(86.9) == 2 && NL(87.0) == 2 && NL(-87.0) == 2, "NL up to the pole cap");
+    static_assert(NL(87.000001) == 1 && NL(90.0) == 1, "NL above the pole cap");
+    static_assert(NL(10.47047130) == 58, "NL transitions are inclusive below 87");
+
+    /**
+     * Most recent even and odd frame of one aircraft
+     */
+    struct FrameState {
+        int lat[2] = {0, 0};            // [0] even, [1] odd
+        int lon[2] = {0, 0};
+        int64_t timeMs[2] = {0, 0};     // 0 = not received
+        bool surface[2] = {false, false};
+        int64_t lastFixMs = 0;          // Last successful decode, reference for local decodes
+
+        void record(bool odd, int cprLat, int cprLon, bool isSurface, int64_t nowMs) {
+            int i = odd ? 1 : 0;
+            lat[i] = cprLat;
+            lon[i] = cprLon;
+            timeMs[i] = nowMs;
+            surface[i] = isSurface;
+        }
+
+        // Even and odd frames of the same kind, close enough together for a global decode
+        bool hasPair() const {
+            if (timeMs[0] == 0 || timeMs[1] == 0 || surface[0] != surface[1]) return false;
+            int64_t gap = timeMs[0] > timeMs[1] ? timeMs[0] - timeMs[1] : timeMs[1] - timeMs[0];
+            return gap <= (surface[0] ? SURFACE_PAIR_MS : AIRBORNE_PAIR_MS);
+        }
+
+        bool oddIsNewer() const { return timeMs[1] > timeMs[0]; }
+    };
+
+    /**
+     * Global decode from an even/odd pair
+     *
+     * Surface pairs only determine the position modulo 90 degrees; the
+     * candidate closest to (refLat, refLon) is chosen. Airborne pairs ignore
+     * the reference.
+     *
+     * @return false if the pair straddles a zone boundary or decodes off the globe
+     */
+    bool decodeGlobal(const FrameState& state, double refLat, double refLon,
+                      double& lat, double& lon);
+
+    /**
+     * Local decode of a single frame relative to a reference position
+     *
+     * The result is only unambiguous if the target lies within half a zone of
+     * the reference (about 180 NM airborne, 45 NM on the surface); anything
+     * further away is rejected.
+     */
+    bool decodeLocal(int cprLat, int cprLon, bool odd, bool surface,
+                     double refLat, double refLon, double& lat, double& lon);
+}
+
+#endif // CPR_H
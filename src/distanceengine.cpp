@@ -0,0 +1,56 @@
+#include "distanceengine.h"
+#include "geobatch.h"
+
+DistanceEngine::DistanceEngine()
+    : DistanceEngine(0.0, 0.0)
+{
+}
+
+DistanceEngine::DistanceEngine(double lat, double lon) {
+    setObserver(lat, lon);
+}
+
+void DistanceEngine::setObserver(double lat, double lon) {
+    m_lat = lat;
+    m_lon = lon;
+    m_sinLat = std::sin(GeoUtils::toRadians(lat));
+    m_cosLat = std::cos(GeoUtils::toRadians(lat));
+    m_absTanLat = std::fabs(m_sinLat / m_cosLat);
+}
+
+void DistanceEngine::distances(const double* lats, const double* lons, size_t count, double* out,
+                               Precision precision, GeoUtils::BatchKernel kernel) const {
+    if (precision == EXACT) {
+        GeoUtils::distanceBearingBatch(m_lat, m_lon, lats, lons, count, out, nullptr, kernel);
+        return;
+    }
+
+    // The kernels take the series limit, 0 for flat earth
+    const double series = precision == DISPLAY ? SERIES_LIMIT : 0.0;
+    switch (GeoUtils::resolveBatchKernel(kernel)) {
+#ifdef GEOBATCH_X86_DISPATCH
+    case GeoUtils::BATCH_AVX2:
+        GeoUtils::fastDistanceBatchAvx2(m_lat, m_lon, lats, lons, count, out, series);
+        break;
+#endif
+#ifdef GEOBATCH_SSE2
+    case GeoUtils::BATCH_SSE2:
+        GeoBatch::runFast<GeoBatch::Sse2Ops>(GeoBatch::observer(m_lat, m_lon, GeoUtils::EARTH_RADIUS),
+                                             lats, lons, count, out, series);
+        break;
+#endif
+    default:
+        GeoBatch::runFast<GeoBatch::ScalarOps>(GeoBatch::observer(m_lat, m_lon, GeoUtils::EARTH_RADIUS),
+                                               lats, lons, count, out, series);
+        break;
+    }
+
+    // Targets the series do not cover, marked -1; rare away from the poles
+    if (precision == DISPLAY) {
+        for (size_t i = 0; i < count; ++i) {
+            if (out[i] < 0.0) {
+                out[i] = GeoUtils::calculateDistance(m_lat, m_lon, lats[i], lons[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,346 @@
+#include "dump1090json.h"
+#include <cmath>
+
+namespace {
+    constexpr double POW10[] = {
+        1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    inline void skipWhitespace(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+    }
+
+    template<size_t N>
+    inline bool keyIs(const char* begin, const char* end, const char (&literal)[N]) {
+        if (static_cast<size_t>(end - begin) != N - 1) return false;
+        for (size_t i = 0; i < N - 1; ++i) {
+            if (begin[i] != literal[i]) return false;
+        }
+        return true;
+    }
+
+    // p at the opening quote; yields the raw contents, escapes left as they are
+    bool readString(const char*& p, const char* end, const char*& begin, const char*& stop) {
+        begin = ++p;
+        while (p < end) {
+            if (*p == '\\') {
+                p += 2;
+            } else if (*p == '"') {
+                stop = p++;
+                return true;
+            } else {
+                ++p;
+            }
+        }
+        return false;
+    }
+
+    // Any JSON value, nested or not, without looking at its contents
+    bool skipValue(const char*& p, const char* end) {
+        if (p >= end) return false;
+
+        if (*p == '"') {
+            const char* b;
+            const char* e;
+            return readString(p, end, b, e);
+        }
+
+        if (*p == '{' || *p == '[') {
+            int depth = 0;
+            while (p < end) {
+                char c = *p;
+                if (c == '"') {
+                    const char* b;
+                    const char* e;
+                    if (!readString(p, end, b, e)) return false;
+                    continue;
+                }
+                if (c == '{' || c == '[') ++depth;
+                else if (c == '}' || c == ']') --depth;
+                ++p;
+                if (depth == 0) return true;
+            }
+            return false;
+        }
+
+        // Number or literal
+        const char* start = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+               *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') {
+            ++p;
+        }
+        return p > start;
+    }
+
+    inline bool isNumberStart(char c) {
+        return c == '-' || (c >= '0' && c <= '9');
+    }
+
+    bool parseNumber(const char*& p, const char* end, double& value) {
+        bool negative = false;
+        if (p < end && *p == '-') {
+            negative = true;
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;             // Significant digits kept in the mantissa
+        int exponent = 0;
+        bool any = false;
+
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+            any = true;
+            if (digits < 18) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa != 0) ++digits;
+            } else {
+                ++exponent;
+            }
+        }
+        if (p < end && *p == '.') {
+            for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+                any = true;
+                if (digits < 18) {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    if (mantissa != 0) ++digits;
+                    --exponent;
+                }
+            }
+        }
+        if (!any) return false;
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            bool negativeExp = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negativeExp = (*p == '-');
+                ++p;
+            }
+            int e = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+                if (e < 1000) e = e * 10 + (*p - '0');
+            }
+            exponent += negativeExp ? -e : e;
+        }
+
+        double v = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            v = (-exponent <= 22) ? v / POW10[-exponent] : v * std::pow(10.0, exponent);
+        } else if (exponent > 0) {
+            v = (exponent <= 22) ? v * POW10[exponent] : v * std::pow(10.0, exponent);
+        }
+        value = negative ? -v : v;
+        return true;
+    }
+
+    bool parseHex24(const char* begin, const char* end, uint32_t& value) {
+        if (end - begin != 6) return false;
+
+        uint32_t v = 0;
+        for (const char* p = begin; p < end; ++p) {
+            char c = *p;
+            uint32_t d;
+            if (c >= '0' && c <= '9') d = c - '0';
+            else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+            else return false;
+            v = (v << 4) | d;
+        }
+        value = v;
+        return true;
+    }
+}
+
+namespace Dump1090Json {
+
+Reader::Reader(const char* data, size_t size)
+    : m_pos(data),
+      m_end(data + size),
+      m_inArray(false),
+      m_done(false),
+      m_error(false),
+      m_now(0.0)
+{
+}
+
+bool Reader::fail() {
+    m_error = true;
+    m_done = true;
+    return false;
+}
+
+bool Reader::enterAircraftArray() {
+    skipWhitespace(m_pos, m_end);
+    if (m_pos >= m_end || *m_pos != '{') return fail();
+    ++m_pos;
+
+    for (;;) {
+        skipWhitespace(m_pos, m_end);
+        if (m_pos < m_end && *m_pos == '}') return false;   // No aircraft array
+        if (m_pos >= m_end || *m_pos != '"') return fail();
+
+        const char* keyBegin;
+        const char* keyEnd;
+        if (!readString(m_pos, m_end, keyBegin, keyEnd)) return fail();
+
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end || *m_pos != ':') return fail();
+        ++m_pos;
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end) return fail();
+
+        if (keyIs(keyBegin, keyEnd, "aircraft")) {
+            if (*m_pos != '[') return fail();
+            ++m_pos;
+            m_inArray = true;
+            return true;
+        }
+
+        if (keyIs(keyBegin, keyEnd, "now") && isNumberStart(*m_pos)) {
+            if (!parseNumber(m_pos, m_end, m_now)) return fail();
+        } else if (!skipValue(m_pos, m_end)) {
+            return fail();
+        }
+
+        skipWhitespace(m_pos, m_end);
+        if (m_pos < m_end && *m_pos == ',') ++m_pos;
+    }
+}
+
+bool Reader::next(Entry& out) {
+    if (m_done) return false;
+    if (!m_inArray && !enterAircraftArray()) {
+        m_done = true;
+        return false;
+    }
+
+    for (;;) {
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end) return fail();
+
+        if (*m_pos == ']') {
+            ++m_pos;
+            m_done = true;
+            return false;
+        }
+        if (*m_pos == ',') {
+            ++m_pos;
+            continue;
+        }
+        if (*m_pos != '{') {
+            if (!skipValue(m_pos, m_end)) return fail();
+            continue;
+        }
+
+        bool valid;
+        if (!parseObject(out, valid)) return false;
+        if (valid) return true;
+    }
+}
+
+bool Reader::parseObject(Entry& out, bool& valid) {
+    ++m_pos;    // '{'
+    out = Entry();
+    valid = false;
+
+    bool hasLat = false;
+    bool hasLon = false;
+
+    skipWhitespace(m_pos, m_end);
+    if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+        return true;
+    }
+
+    for (;;) {
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end || *m_pos != '"') return fail();
+
+        const char* key;
+        const char* keyEnd;
+        if (!readString(m_pos, m_end, key, keyEnd)) return fail();
+
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end || *m_pos != ':') return fail();
+        ++m_pos;
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end) return fail();
+
+        if (*m_pos == '"') {
+            const char* value;
+            const char* valueEnd;
+            if (!readString(m_pos, m_end, value, valueEnd)) return fail();
+
+            if (keyIs(key, keyEnd, "hex")) {
+                if (value < valueEnd && *value == '~') {
+                    out.nonIcao = true;
+                    ++value;
+                }
+                valid = parseHex24(value, valueEnd, out.icao);
+            } else if (keyIs(key, keyEnd, "flight")) {
+                int n = 0;
+                for (const char* c = value; c < valueEnd && n < 8; ++c) {
+                    out.callsign[n++] = *c;
+                }
+                while (n > 0 && out.callsign[n - 1] == ' ') --n;
+                out.callsign[n] = '\0';
+                out.hasCallsign = true;
+            } else if (keyIs(key, keyEnd, "squawk")) {
+                int squawk = 0;
+                const char* c = value;
+                for (; c < valueEnd && *c >= '0' && *c <= '9'; ++c) {
+                    squawk = squawk * 10 + (*c - '0');
+                }
+                out.hasSquawk = (c == valueEnd && c > value);
+                out.squawk = squawk;
+            } else if (keyIs(key, keyEnd, "alt_baro") || keyIs(key, keyEnd, "altitude")) {
+                out.onGround = keyIs(value, valueEnd, "ground");
+            }
+        } else if (isNumberStart(*m_pos)) {
+            double v;
+            if (!parseNumber(m_pos, m_end, v)) return fail();
+
+            if (keyIs(key, keyEnd, "lat")) {
+                out.lat = v;
+                hasLat = true;
+            } else if (keyIs(key, keyEnd, "lon")) {
+                out.lon = v;
+                hasLon = true;
+            } else if (keyIs(key, keyEnd, "alt_baro") || keyIs(key, keyEnd, "altitude")) {
+                out.altitudeFt = v;
+                out.hasAltitude = true;
+            } else if (keyIs(key, keyEnd, "gs")) {
+                out.groundSpeedKt = v;
+                out.hasGroundSpeed = true;
+            } else if (keyIs(key, keyEnd, "track")) {
+                out.trackDeg = v;
+                out.hasTrack = true;
+            } else if (keyIs(key, keyEnd, "baro_rate") || keyIs(key, keyEnd, "vert_rate")) {
+                out.verticalRateFpm = v;
+                out.hasVerticalRate = true;
+            } else if (keyIs(key, keyEnd, "seen")) {
+                out.seen = v;
+            } else if (keyIs(key, keyEnd, "seen_pos")) {
+                out.seenPos = v;
+            }
+        } else if (!skipValue(m_pos, m_end)) {
+            return fail();
+        }
+
+        skipWhitespace(m_pos, m_end);
+        if (m_pos >= m_end) return fail();
+        if (*m_pos == ',') {
+            ++m_pos;
+            continue;
+        }
+        if (*m_pos == '}') {
+            ++m_pos;
+            out.hasPosition = hasLat && hasLon;
+            return true;
+        }
+        return fail();
+    }
+}
+
+}
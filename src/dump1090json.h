@@ -0,0 +1,86 @@
+#ifndef DUMP1090JSON_H
+#define DUMP1090JSON_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Pull parser for dump1090 / readsb aircraft.json
+ *
+ *   { "now": 1700000000.0, "messages": 123,
+ *     "aircraft": [ { "hex": "4840d6", "flight": "KLM1023 ", "lat": 52.2,
+ *                     "lon": 3.9, "alt_baro": 38000, "gs": 450.2, ... }, ... ] }
+ *
+ * The document is walked in place: each next() call scans one aircraft
+ * object and fills a fixed-size Entry. Keys the tracker does not use
+ * (including nested arrays such as "mlat" or "nav_modes") are skipped
+ * without being materialized, so a poll allocates nothing.
+ */
+namespace Dump1090Json {
+    struct Entry {
+        uint32_t icao = 0;
+        bool nonIcao = false;       // "~" prefixed address (TIS-B, anonymous)
+
+        bool hasCallsign = false;
+        char callsign[9] = {};      // Trailing spaces stripped
+
+        bool hasPosition = false;
+        double lat = 0.0;
+        double lon = 0.0;
+
+        bool hasAltitude = false;
+        bool onGround = false;      // "alt_baro": "ground"
+        double altitudeFt = 0.0;
+
+        bool hasGroundSpeed = false;
+        double groundSpeedKt = 0.0;
+
+        bool hasTrack = false;
+        double trackDeg = 0.0;
+
+        bool hasVerticalRate = false;
+        double verticalRateFpm = 0.0;
+
+        bool hasSquawk = false;
+        int squawk = 0;             // Four octal digits as written, e.g. 7700
+
+        double seen = 0.0;          // Seconds since the last message from this aircraft
+        double seenPos = -1.0;      // Seconds since the last position, -1 if not given
+    };
+
+    class Reader {
+    public:
+        /**
+         * @param data Document text; must stay valid while the reader is used
+         */
+        Reader(const char* data, size_t size);
+
+        /**
+         * Parse the next aircraft object
+         *
+         * Objects without a valid "hex" address are skipped.
+         *
+         * @return false at the end of the "aircraft" array or on malformed input
+         */
+        bool next(Entry& out);
+
+        bool hasError() const { return m_error; }
+
+        // Top-level "now" (Unix seconds), if it precedes the aircraft array
+        double now() const { return m_now; }
+
+    private:
+        const char* m_pos;
+        const char* m_end;
+        bool m_inArray;
+        bool m_done;
+        bool m_error;
+        double m_now;
+
+        bool enterAircraftArray();
+        bool parseObject(Entry& out, bool& valid);
+        bool fail();
+    };
+}
+
+#endif // DUMP1090JSON_H
@@ -0,0 +1,215 @@
+#include "feedrecording.h"
+#include <cstring>
+
+namespace FeedRecording {
+
+namespace {
+    const char FILE_MAGIC[8] = {'F', 'E', 'E', 'D', 'R', 'E', 'C', '1'};
+    const char INDEX_MAGIC[8] = {'F', 'E', 'E', 'D', 'I', 'D', 'X', '1'};
+
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr size_t RECORD_HEADER_SIZE = 16;
+    constexpr size_t INDEX_ENTRY_SIZE = 24;
+    constexpr size_t TRAILER_SIZE = 24;
+
+    void put32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    void put64(uint8_t* p, uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    uint32_t get32(const uint8_t* p) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    uint64_t get64(const uint8_t* p) {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    bool seek(std::FILE* file, uint64_t offset) {
+        return std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+    }
+
+    bool readExact(std::FILE* file, void* buffer, size_t size) {
+        return std::fread(buffer, 1, size, file) == size;
+    }
+}
+
+bool Writer::open(const std::string& path, const char* tag, uint32_t source) {
+    close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) return false;
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, FILE_MAGIC, 8);
+    std::memset(header + 8, ' ', 4);
+    for (int i = 0; i < 4 && tag && tag[i]; ++i) header[8 + i] = static_cast<uint8_t>(tag[i]);
+    put32(header + 12, source);
+
+    if (std::fwrite(header, 1, HEADER_SIZE, m_file) != HEADER_SIZE) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_offset = HEADER_SIZE;
+    m_startNs = 0;
+    m_index.clear();
+    return true;
+}
+
+bool Writer::append(Kind kind, const char* data, size_t size, int64_t nowNs) {
+    if (!m_file || size > UINT32_MAX) return false;
+
+    if (m_index.empty()) m_startNs = nowNs;
+
+    Entry entry;
+    entry.timeNs = nowNs - m_startNs;
+    entry.offset = m_offset + RECORD_HEADER_SIZE;
+    entry.length = static_cast<uint32_t>(size);
+    entry.kind = kind;
+
+    uint8_t header[RECORD_HEADER_SIZE] = {};
+    put64(header, static_cast<uint64_t>(entry.timeNs));
+    put32(header + 8, entry.length);
+    header[12] = entry.kind;
+
+    if (std::fwrite(header, 1, RECORD_HEADER_SIZE, m_file) != RECORD_HEADER_SIZE
+            || std::fwrite(data, 1, size, m_file) != size) {
+        return false;
+    }
+
+    m_offset = entry.offset + size;
+    m_index.push_back(entry);
+    return true;
+}
+
+void Writer::close() {
+    if (!m_file) return;
+
+    uint64_t indexOffset = m_offset;
+    uint8_t buffer[INDEX_ENTRY_SIZE];
+    for (const Entry& entry : m_index) {
+        std::memset(buffer, 0, sizeof(buffer));
+        put64(buffer, static_cast<uint64_t>(entry.timeNs));
+        put64(buffer + 8, entry.offset);
+        put32(buffer + 16, entry.length);
+        buffer[20] = entry.kind;
+        std::fwrite(buffer, 1, INDEX_ENTRY_SIZE, m_file);
+    }
+
+    uint8_t trailer[TRAILER_SIZE];
+    put64(trailer, indexOffset);
+    put64(trailer + 8, m_index.size());
+    std::memcpy(trailer + 16, INDEX_MAGIC, 8);
+    std::fwrite(trailer, 1, TRAILER_SIZE, m_file);
+
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_index.clear();
+}
+
+bool Reader::open(const std::string& path) {
+    close();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) return false;
+
+    uint8_t header[HEADER_SIZE];
+    if (!readExact(m_file, header, HEADER_SIZE) || std::memcmp(header, FILE_MAGIC, 8) != 0) {
+        close();
+        return false;
+    }
+    std::memcpy(m_tag, header + 8, 4);
+    m_tag[4] = '\0';
+    m_source = get32(header + 12);
+
+    std::fseek(m_file, 0, SEEK_END);
+    long end = std::ftell(m_file);
+    uint64_t fileSize = end > 0 ? static_cast<uint64_t>(end) : 0;
+
+    if (!loadIndex(fileSize)) scanRecords(fileSize);
+    return true;
+}
+
+void Reader::close() {
+    if (m_file) std::fclose(m_file);
+    m_file = nullptr;
+    m_tag[0] = '\0';
+    m_source = 0;
+    m_index.clear();
+}
+
+bool Reader::loadIndex(uint64_t fileSize) {
+    if (fileSize < HEADER_SIZE + TRAILER_SIZE) return false;
+
+    uint8_t trailer[TRAILER_SIZE];
+    if (!seek(m_file, fileSize - TRAILER_SIZE) || !readExact(m_file, trailer, TRAILER_SIZE)
+            || std::memcmp(trailer + 16, INDEX_MAGIC, 8) != 0) {
+        return false;
+    }
+
+    uint64_t indexOffset = get64(trailer);
+    uint64_t count = get64(trailer + 8);
+    if (indexOffset < HEADER_SIZE || indexOffset + count * INDEX_ENTRY_SIZE != fileSize - TRAILER_SIZE) {
+        return false;
+    }
+
+    std::vector<uint8_t> raw(static_cast<size_t>(count * INDEX_ENTRY_SIZE));
+    if (!seek(m_file, indexOffset) || !readExact(m_file, raw.data(), raw.size())) return false;
+
+    m_index.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < m_index.size(); ++i) {
+        const uint8_t* p = raw.data() + i * INDEX_ENTRY_SIZE;
+        Entry& entry = m_index[i];
+        entry.timeNs = static_cast<int64_t>(get64(p));
+        entry.offset = get64(p + 8);
+        entry.length = get32(p + 16);
+        entry.kind = p[20];
+        if (entry.offset + entry.length > indexOffset) {
+            m_index.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void Reader::scanRecords(uint64_t fileSize) {
+    m_index.clear();
+
+    uint64_t offset = HEADER_SIZE;
+    uint8_t header[RECORD_HEADER_SIZE];
+    while (offset + RECORD_HEADER_SIZE <= fileSize) {
+        if (!seek(m_file, offset) || !readExact(m_file, header, RECORD_HEADER_SIZE)) break;
+
+        Entry entry;
+        entry.timeNs = static_cast<int64_t>(get64(header));
+        entry.offset = offset + RECORD_HEADER_SIZE;
+        entry.length = get32(header + 8);
+        entry.kind = header[12];
+
+        // A record the writer did not finish ends the recording
+        if (entry.offset + entry.length > fileSize) break;
+        if (entry.kind != HTTP_BODY && entry.kind != STREAM_BYTES) break;
+
+        m_index.push_back(entry);
+        offset = entry.offset + entry.length;
+    }
+}
+
+bool Reader::read(size_t i, std::vector<char>& out) {
+    if (!m_file || i >= m_index.size()) return false;
+
+    const Entry& entry = m_index[i];
+    out.resize(entry.length);
+    if (entry.length == 0) return true;
+    return seek(m_file, entry.offset) && readExact(m_file, out.data(), entry.length);
+}
+
+}
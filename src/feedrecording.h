@@ -0,0 +1,98 @@
+#ifndef FEEDRECORDING_H
+#define FEEDRECORDING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Raw feed recordings: every payload a client received, with its arrival time
+ *
+ * File layout (all integers little-endian):
+ *
+ *   header   "FEEDREC1" | tag[4] | u32 source                      16 bytes
+ *   record   i64 timeNs | u32 length | u8 kind | 3 pad | payload   16 + length
+ *   ...
+ *   index    one {i64 timeNs, u64 offset, u32 length, u8 kind, 3 pad} per record
+ *   trailer  u64 indexOffset | u64 count | "FEEDIDX1"              24 bytes
+ *
+ * Times are MonotonicClock nanoseconds since the first record. The tag names
+ * the client ("adsb", "rckt") and source is its Source enum value, so a
+ * recording knows which parser its payloads belong to. The index is written
+ * by close(); a file cut short by a crash has no trailer and is read by
+ * walking the records instead, up to the last complete one.
+ */
+namespace FeedRecording {
+    enum Kind : uint8_t {
+        HTTP_BODY = 1,      // One complete response body
+        STREAM_BYTES = 2    // One socket read, cut anywhere
+    };
+
+    struct Entry {
+        int64_t timeNs;
+        uint64_t offset;    // Of the payload
+        uint32_t length;
+        uint8_t kind;
+    };
+
+    class Writer {
+    public:
+        Writer() = default;
+        ~Writer() { close(); }
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        // Truncates path; tag is padded or cut to four characters
+        bool open(const std::string& path, const char* tag, uint32_t source);
+        bool isOpen() const { return m_file != nullptr; }
+
+        // nowNs is MonotonicClock time; the first record defines time zero
+        bool append(Kind kind, const char* data, size_t size, int64_t nowNs);
+
+        // Write the index and trailer
+        void close();
+
+        size_t count() const { return m_index.size(); }
+
+    private:
+        std::FILE* m_file = nullptr;
+        uint64_t m_offset = 0;
+        int64_t m_startNs = 0;
+        std::vector<Entry> m_index;
+    };
+
+    class Reader {
+    public:
+        Reader() = default;
+        ~Reader() { close(); }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return m_file != nullptr; }
+
+        const char* tag() const { return m_tag; }
+        uint32_t source() const { return m_source; }
+
+        size_t count() const { return m_index.size(); }
+        const Entry& entry(size_t i) const { return m_index[i]; }
+        int64_t durationNs() const { return m_index.empty() ? 0 : m_index.back().timeNs; }
+
+        // Payload of record i into out (resized)
+        bool read(size_t i, std::vector<char>& out);
+
+    private:
+        std::FILE* m_file = nullptr;
+        char m_tag[5] = {};
+        uint32_t m_source = 0;
+        std::vector<Entry> m_index;
+
+        bool loadIndex(uint64_t fileSize);
+        void scanRecords(uint64_t fileSize);
+    };
+}
+
+#endif // FEEDRECORDING_H
@@ -0,0 +1,116 @@
+#include "feedreplay.h"
+#include "monotonicclock.h"
+#include <QFile>
+#include <algorithm>
+
+FeedReplay::FeedReplay(QObject* parent)
+    : QObject(parent),
+      m_timer(new QTimer(this)),
+      m_speed(1.0),
+      m_running(false),
+      m_next(0),
+      m_startNs(0)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &FeedReplay::deliver);
+}
+
+bool FeedReplay::open(const QString& path) {
+    stop();
+    return m_reader.open(QFile::encodeName(path).toStdString());
+}
+
+void FeedReplay::close() {
+    stop();
+    m_reader.close();
+}
+
+void FeedReplay::setSpeed(double speed) {
+    speed = speed > 0.0 ? speed : 0.0;
+
+    if (m_running && m_next < m_reader.count()) {
+        // Continue from the next payload at the new pace
+        int64_t nowNs = MonotonicClock::nowNs();
+        int64_t position = m_speed > 0.0
+            ? static_cast<int64_t>((nowNs - m_startNs) * m_speed)
+            : m_reader.entry(m_next).timeNs;
+        m_startNs = speed > 0.0 ? nowNs - static_cast<int64_t>(position / speed) : nowNs;
+        m_speed = speed;
+        scheduleNext();
+        return;
+    }
+
+    m_speed = speed;
+}
+
+void FeedReplay::start() {
+    stop();
+    if (!m_reader.isOpen()) return;
+
+    m_running = true;
+    m_next = 0;
+    m_startNs = MonotonicClock::nowNs();
+    scheduleNext();
+}
+
+void FeedReplay::stop() {
+    m_running = false;
+    m_timer->stop();
+}
+
+int64_t FeedReplay::positionNs() const {
+    if (!m_reader.isOpen() || m_next == 0) return 0;
+
+    int64_t lastNs = m_reader.entry(m_next - 1).timeNs;
+    if (!m_running || m_speed <= 0.0) return lastNs;
+
+    int64_t elapsedNs = static_cast<int64_t>((MonotonicClock::nowNs() - m_startNs) * m_speed);
+    if (m_next >= m_reader.count()) return std::max(elapsedNs, lastNs);
+    return std::clamp(elapsedNs, lastNs, m_reader.entry(m_next).timeNs);
+}
+
+int64_t FeedReplay::dueNs(size_t index) const {
+    return m_startNs + static_cast<int64_t>(m_reader.entry(index).timeNs / m_speed);
+}
+
+void FeedReplay::scheduleNext() {
+    if (m_next >= m_reader.count()) {
+        m_running = false;
+        emit finished();
+        return;
+    }
+
+    int msec = 0;
+    if (m_speed > 0.0) {
+        // Round up, so the timer never fires before the payload is due
+        int64_t waitNs = dueNs(m_next) - MonotonicClock::nowNs();
+        if (waitNs > 0) {
+            msec = static_cast<int>((waitNs + MonotonicClock::NS_PER_MS - 1) / MonotonicClock::NS_PER_MS);
+        }
+    }
+    m_timer->start(msec);
+}
+
+void FeedReplay::deliver() {
+    int64_t nowNs = MonotonicClock::nowNs();
+    int batch = 0;
+
+    // Everything already due goes out now; a receiver may stop() the replay
+    while (m_running && m_next < m_reader.count()) {
+        if (m_speed > 0.0 ? dueNs(m_next) > nowNs : batch == BATCH_SIZE) break;
+
+        const FeedRecording::Entry& entry = m_reader.entry(m_next);
+        int kind = entry.kind;
+        int64_t timeNs = entry.timeNs;
+        if (!m_reader.read(m_next, m_buffer)) {
+            m_next = m_reader.count();
+            break;
+        }
+        ++m_next;
+        ++batch;
+        emit payload(kind, timeNs, QByteArray(m_buffer.data(), static_cast<int>(m_buffer.size())));
+    }
+
+    if (m_running) scheduleNext();
+}
@@ -0,0 +1,83 @@
+#ifndef FEEDREPLAY_H
+#define FEEDREPLAY_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QTimer>
+#include <vector>
+#include "feedrecording.h"
+
+/**
+ * Plays a FeedRecording back through the event loop
+ *
+ * Payloads are emitted in recorded order at their recorded offsets divided by
+ * the speed. Due times are computed from the start of playback rather than
+ * from the previous payload, so timer latency never accumulates: each payload
+ * is delivered on or just after its due time (millisecond timer resolution).
+ * Speed 0 plays as fast as possible, in batches that keep the event loop
+ * responsive.
+ *
+ * Each payload carries its recorded time, and positionNs() tells how far
+ * playback has got, so a receiver can run its own clock on recording time
+ * and process the same traffic identically at any speed.
+ */
+class FeedReplay : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int BATCH_SIZE = 64;  // Payloads per event loop pass at speed 0
+
+    explicit FeedReplay(QObject* parent = nullptr);
+    ~FeedReplay() override = default;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_reader.isOpen(); }
+
+    // Which client and source produced the recording
+    QString tag() const { return QString::fromLatin1(m_reader.tag()).trimmed(); }
+    uint32_t source() const { return m_reader.source(); }
+
+    size_t count() const { return m_reader.count(); }
+    int64_t durationNs() const { return m_reader.durationNs(); }
+
+    // 1 = recorded pace, 10 = ten times faster, 0 = as fast as possible
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+
+    void start();   // From the first payload
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    /**
+     * Recording time (ns since the first payload) that playback has reached
+     *
+     * Scaled elapsed time, but never before the last delivered payload nor
+     * past the next undelivered one. At speed 0 and when stopped, the time of
+     * the last delivered payload.
+     */
+    int64_t positionNs() const;
+
+signals:
+    // kind is a FeedRecording::Kind, timeNs the recorded time since the first payload
+    void payload(int kind, qint64 timeNs, const QByteArray& data);
+    void finished();
+
+private slots:
+    void deliver();
+
+private:
+    FeedRecording::Reader m_reader;
+    QTimer* m_timer;
+    double m_speed;
+    bool m_running;
+    size_t m_next;          // Index of the next payload
+    int64_t m_startNs;      // MonotonicClock time of recording offset 0
+    std::vector<char> m_buffer;
+
+    int64_t dueNs(size_t index) const;
+    void scheduleNext();
+};
+
+#endif // FEEDREPLAY_H
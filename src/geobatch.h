@@ -0,0 +1,503 @@
+#ifndef GEOBATCH_H
+#define GEOBATCH_H
+
+// Internal to geoutils.cpp, distanceengine.cpp, lookangles.cpp and
+// geoutils_avx2.cpp: the batch geodesy kernels, written once against a small vector interface and
+// instantiated per instruction set. Everything here has internal linkage, so the copies built
+// for different targets never get merged by the linker.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// SSE2 kernels: always on x86-64, on 32-bit x86 when the compiler targets it
+#if defined(__SSE2__) || defined(_M_X64)
+#define GEOBATCH_SSE2
+#include <immintrin.h>
+#endif
+
+// AVX2 kernels in geoutils_avx2.cpp: GCC or Clang on x86, picked at run time
+// by GeoUtils::resolveBatchKernel()
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GEOBATCH_X86_DISPATCH
+
+namespace GeoUtils {
+    void distanceBearingBatchAvx2(double lat, double lon, const double* lats, const double* lons,
+                                  size_t count, double* distances, double* bearings);
+    void fastDistanceBatchAvx2(double lat, double lon, const double* lats, const double* lons,
+                               size_t count, double* distances, double seriesLimit);
+    void lookAnglesBatchAvx2(double lat, double lon, double altitude, double a, double e2,
+                             const double* lats, const double* lons, const double* altitudes, size_t count,
+                             double* ranges, double* azimuths, double* elevations);
+}
+#endif
+
+namespace {
+namespace GeoBatch {
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double DEG_TO_RAD = PI / 180.0;
+    constexpr double RAD_TO_DEG = 180.0 / PI;
+
+    // pi/2 split so that q * PIO2_HI is exact for the small q used here
+    constexpr double PIO2_HI = 1.57079632673412561417e+00;
+    constexpr double PIO2_LO = 6.07710050650619224932e-11;
+
+    // Cephes minimax coefficients on [-pi/4, pi/4]
+    constexpr double SIN_C[] = {
+        1.58962301576546568060e-10, -2.50507477628578072866e-8,
+        2.75573136213857245213e-6, -1.98412698295895385996e-4,
+        8.33333333332211858878e-3, -1.66666666666666307295e-1
+    };
+    constexpr double COS_C[] = {
+        -1.13585365213876817300e-11, 2.08757008419747316778e-9,
+        -2.75573141792967388112e-7, 2.48015872888517045348e-5,
+        -1.38888888888730564116e-3, 4.16666666666665929218e-2
+    };
+
+    // Cephes atan: rational approximation on [0, 0.66]
+    constexpr double ATAN_P[] = {
+        -8.750608600031904122785e-1, -1.615753718733365076637e1,
+        -7.500855792314704667340e1, -1.228866684490136173410e2,
+        -6.485021904942025371773e1
+    };
+    constexpr double ATAN_Q[] = {     // Leading coefficient 1 implied
+        2.485846490142306297962e1, 1.650270098316988542046e2,
+        4.328810604912902668951e2, 4.853903996359136964868e2,
+        1.945506571482613964425e2
+    };
+    constexpr double ATAN_SPLIT = 0.66;
+    constexpr double MOREBITS = 6.123233995736765886130e-17;   // pi/2 - double(pi/2)
+
+    struct Observer {
+        double latDeg;
+        double lon;         // degrees
+        double lat;         // radians
+        double sinLat;
+        double cosLat;
+        double radius;      // meters
+    };
+
+    inline Observer observer(double lat, double lon, double radius) {
+        Observer o;
+        o.latDeg = lat;
+        o.lon = lon;
+        o.lat = lat * DEG_TO_RAD;
+        o.sinLat = std::sin(o.lat);
+        o.cosLat = std::cos(o.lat);
+        o.radius = radius;
+        return o;
+    }
+
+    /**
+     * One lane: also finishes the tail of every vector loop, so all kernels
+     * agree with each other to the last bit that FMA contraction allows.
+     */
+    struct ScalarOps {
+        using V = double;
+        using M = bool;
+        static constexpr size_t WIDTH = 1;
+
+        static V load(const double* p) { return *p; }
+        static void store(double* p, V v) { *p = v; }
+        static V set(double x) { return x; }
+        static V add(V a, V b) { return a + b; }
+        static V sub(V a, V b) { return a - b; }
+        static V mul(V a, V b) { return a * b; }
+        static V div(V a, V b) { return a / b; }
+        static V sqrt(V a) { return std::sqrt(a); }
+        static V min(V a, V b) { return b < a ? b : a; }
+        static V max(V a, V b) { return a < b ? b : a; }
+        static V abs(V a) { return std::fabs(a); }
+        static V round(V a) { return std::nearbyint(a); }
+        static M lt(V a, V b) { return a < b; }
+        static M gt(V a, V b) { return a > b; }
+        static M ne(V a, V b) { return a != b; }
+        static V select(M m, V a, V b) { return m ? a : b; }
+    };
+
+#ifdef GEOBATCH_SSE2
+    struct Sse2Ops {
+        using V = __m128d;
+        using M = __m128d;
+        static constexpr size_t WIDTH = 2;
+
+        static V load(const double* p) { return _mm_loadu_pd(p); }
+        static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+        static V set(double x) { return _mm_set1_pd(x); }
+        static V add(V a, V b) { return _mm_add_pd(a, b); }
+        static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+        static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+        static V div(V a, V b) { return _mm_div_pd(a, b); }
+        static V sqrt(V a) { return _mm_sqrt_pd(a); }
+        static V min(V a, V b) { return _mm_min_pd(a, b); }
+        static V max(V a, V b) { return _mm_max_pd(a, b); }
+        static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+        // Small integers only; the current rounding mode is round-to-nearest
+        static V round(V a) { return _mm_cvtepi32_pd(_mm_cvtpd_epi32(a)); }
+        static M lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+        static M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+        static M ne(V a, V b) { return _mm_cmpneq_pd(a, b); }
+        static V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    };
+#endif
+
+#ifdef GEOBATCH_AVX2
+    // Only in geoutils_avx2.cpp, which compiles this file for AVX2 and FMA
+    struct Avx2Ops {
+        using V = __m256d;
+        using M = __m256d;
+        static constexpr size_t WIDTH = 4;
+
+        static V load(const double* p) { return _mm256_loadu_pd(p); }
+        static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+        static V set(double x) { return _mm256_set1_pd(x); }
+        static V add(V a, V b) { return _mm256_add_pd(a, b); }
+        static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+        static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+        static V div(V a, V b) { return _mm256_div_pd(a, b); }
+        static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+        static V min(V a, V b) { return _mm256_min_pd(a, b); }
+        static V max(V a, V b) { return _mm256_max_pd(a, b); }
+        static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+        static V round(V a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+        static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static M ne(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+        static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+    };
+#endif
+
+    template<typename Ops, size_t N>
+    typename Ops::V poly(typename Ops::V z, const double (&c)[N]) {
+        typename Ops::V r = Ops::set(c[0]);
+        for (size_t i = 1; i < N; ++i) r = Ops::add(Ops::mul(r, z), Ops::set(c[i]));
+        return r;
+    }
+
+    // sin and cos of x for |x| <= 3*pi/4
+    template<typename Ops>
+    void sincos(typename Ops::V x, typename Ops::V& s, typename Ops::V& c) {
+        using V = typename Ops::V;
+
+        // Nearest multiple of pi/2 (-1, 0 or 1), remainder in [-pi/4, pi/4]
+        V q = Ops::round(Ops::mul(x, Ops::set(2.0 / PI)));
+        V r = Ops::sub(Ops::sub(x, Ops::mul(q, Ops::set(PIO2_HI))), Ops::mul(q, Ops::set(PIO2_LO)));
+        V z = Ops::mul(r, r);
+
+        V sr = Ops::add(r, Ops::mul(Ops::mul(r, z), poly<Ops>(z, SIN_C)));
+        V cr = Ops::add(Ops::sub(Ops::set(1.0), Ops::mul(Ops::set(0.5), z)),
+                        Ops::mul(Ops::mul(z, z), poly<Ops>(z, COS_C)));
+
+        // sin(r + q*pi/2) = q*cos(r), cos(r + q*pi/2) = -q*sin(r) for q = +-1
+        typename Ops::M swap = Ops::ne(q, Ops::set(0.0));
+        s = Ops::select(swap, Ops::mul(q, cr), sr);
+        c = Ops::select(swap, Ops::sub(Ops::set(0.0), Ops::mul(q, sr)), cr);
+    }
+
+    // atan(t) for 0 <= t <= 1
+    template<typename Ops>
+    typename Ops::V atanUnit(typename Ops::V t) {
+        using V = typename Ops::V;
+
+        typename Ops::M big = Ops::gt(t, Ops::set(ATAN_SPLIT));
+        V x = Ops::select(big, Ops::div(Ops::sub(t, Ops::set(1.0)), Ops::add(t, Ops::set(1.0))), t);
+        V base = Ops::select(big, Ops::set(PI / 4.0), Ops::set(0.0));
+        V more = Ops::select(big, Ops::set(0.5 * MOREBITS), Ops::set(0.0));
+
+        V z = Ops::mul(x, x);
+        V q = Ops::set(1.0);
+        for (double c : ATAN_Q) q = Ops::add(Ops::mul(q, z), Ops::set(c));
+        V r = Ops::add(x, Ops::mul(Ops::mul(x, z), Ops::div(poly<Ops>(z, ATAN_P), q)));
+        return Ops::add(base, Ops::add(r, more));
+    }
+
+    // atan2(y, x) in [0, pi/2] for y, x >= 0
+    template<typename Ops>
+    typename Ops::V atan2Positive(typename Ops::V y, typename Ops::V x) {
+        using V = typename Ops::V;
+        V lo = Ops::min(y, x);
+        V hi = Ops::max(Ops::max(y, x), Ops::set(1e-300));
+        V t = atanUnit<Ops>(Ops::div(lo, hi));
+        return Ops::select(Ops::gt(y, x), Ops::sub(Ops::set(PI / 2.0), t), t);
+    }
+
+    // atan2(y, x) mapped to [0, 2*pi)
+    template<typename Ops>
+    typename Ops::V atan2Full(typename Ops::V y, typename Ops::V x) {
+        using V = typename Ops::V;
+        V zero = Ops::set(0.0);
+        V a = atan2Positive<Ops>(Ops::abs(y), Ops::abs(x));
+        a = Ops::select(Ops::lt(x, zero), Ops::sub(Ops::set(PI), a), a);
+        a = Ops::select(Ops::lt(y, zero), Ops::sub(Ops::set(2.0 * PI), a), a);
+        return Ops::select(Ops::lt(a, Ops::set(2.0 * PI)), a, zero);
+    }
+
+    /**
+     * Haversine distance and initial bearing, Ops::WIDTH points per step
+     *
+     * Both come from the same five trig values: sin/cos of the target
+     * latitude, sin/cos of half the longitude difference and sin of half the
+     * latitude difference. The half-angle forms keep small distances exact
+     * where 1 - cos(x) would cancel.
+     */
+    template<typename Ops, bool BEARINGS>
+    size_t distanceBearing(const Observer& o, const double* lats, const double* lons, size_t count,
+                           double* distances, double* bearings) {
+        using V = typename Ops::V;
+        const V degToRad = Ops::set(DEG_TO_RAD);
+        const V half = Ops::set(0.5);
+        const V one = Ops::set(1.0);
+        const V zero = Ops::set(0.0);
+
+        size_t i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH) {
+            V latDeg = Ops::load(lats + i);
+            V lat = Ops::mul(latDeg, degToRad);
+
+            // Longitude difference wrapped to [-180, 180]
+            V dLon = Ops::sub(Ops::load(lons + i), Ops::set(o.lon));
+            dLon = Ops::sub(dLon, Ops::mul(Ops::round(Ops::mul(dLon, Ops::set(1.0 / 360.0))), Ops::set(360.0)));
+            V halfLon = Ops::mul(Ops::mul(dLon, degToRad), half);
+            // Differences in degrees first, as calculateDistance() does: exact for nearby points
+            V halfLat = Ops::mul(Ops::mul(Ops::sub(latDeg, Ops::set(o.latDeg)), degToRad), half);
+
+            V sinLat, cosLat, sinHalfLon, cosHalfLon, sinHalfLat, unused;
+            sincos<Ops>(lat, sinLat, cosLat);
+            sincos<Ops>(halfLon, sinHalfLon, cosHalfLon);
+            sincos<Ops>(halfLat, sinHalfLat, unused);
+
+            V a = Ops::add(Ops::mul(sinHalfLat, sinHalfLat),
+                           Ops::mul(Ops::mul(Ops::set(o.cosLat), cosLat), Ops::mul(sinHalfLon, sinHalfLon)));
+            a = Ops::min(Ops::max(a, zero), one);
+            V c = atan2Positive<Ops>(Ops::sqrt(a), Ops::sqrt(Ops::sub(one, a)));
+            Ops::store(distances + i, Ops::mul(c, Ops::set(2.0 * o.radius)));
+
+            if (BEARINGS) {
+                V sinDLon = Ops::mul(Ops::set(2.0), Ops::mul(sinHalfLon, cosHalfLon));
+                V cosDLon = Ops::sub(one, Ops::mul(Ops::set(2.0), Ops::mul(sinHalfLon, sinHalfLon)));
+                V y = Ops::mul(sinDLon, cosLat);
+                V x = Ops::sub(Ops::mul(Ops::set(o.cosLat), sinLat),
+                               Ops::mul(Ops::mul(Ops::set(o.sinLat), cosLat), cosDLon));
+                Ops::store(bearings + i, Ops::mul(atan2Full<Ops>(y, x), Ops::set(RAD_TO_DEG)));
+            }
+        }
+        return i;
+    }
+
+    /**
+     * Observer for the look angle kernel, in a frame turned about the polar
+     * axis so that the observer sits at longitude 0: the ENU rotation then
+     * only depends on the latitude, and targets only need sin and cos of
+     * half their longitude difference, which stays within sincos' range.
+     */
+    struct Station {
+        double latDeg;
+        double lon;         // degrees
+        double sinLat;
+        double cosLat;
+        double x;           // ECEF in the turned frame (y = 0), meters
+        double z;
+        double a;           // WGS84 semi-major axis and first eccentricity squared
+        double e2;
+    };
+
+    inline Station station(double lat, double lon, double altitude, double a, double e2) {
+        Station s;
+        s.latDeg = lat;
+        s.lon = lon;
+        s.sinLat = std::sin(lat * DEG_TO_RAD);
+        s.cosLat = std::cos(lat * DEG_TO_RAD);
+        double n = a / std::sqrt(1.0 - e2 * s.sinLat * s.sinLat);
+        s.x = (n + altitude) * s.cosLat;
+        s.z = (n * (1.0 - e2) + altitude) * s.sinLat;
+        s.a = a;
+        s.e2 = e2;
+        return s;
+    }
+
+    /**
+     * Slant range, azimuth and elevation, Ops::WIDTH targets per step
+     *
+     * Geodetic to ECEF for each target, difference with the station, then
+     * the ENU rotation written out for a station at longitude 0.
+     */
+    template<typename Ops, bool ANGLES>
+    size_t lookAngles(const Station& st, const double* lats, const double* lons, const double* altitudes,
+                      size_t count, double* ranges, double* azimuths, double* elevations) {
+        using V = typename Ops::V;
+        const V degToRad = Ops::set(DEG_TO_RAD);
+        const V radToDeg = Ops::set(RAD_TO_DEG);
+        const V one = Ops::set(1.0);
+        const V two = Ops::set(2.0);
+        const V zero = Ops::set(0.0);
+        const V sinLat0 = Ops::set(st.sinLat);
+        const V cosLat0 = Ops::set(st.cosLat);
+
+        size_t i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH) {
+            V lat = Ops::mul(Ops::load(lats + i), degToRad);
+            V dLon = Ops::sub(Ops::load(lons + i), Ops::set(st.lon));
+            dLon = Ops::sub(dLon, Ops::mul(Ops::round(Ops::mul(dLon, Ops::set(1.0 / 360.0))), Ops::set(360.0)));
+            V halfLon = Ops::mul(Ops::mul(dLon, degToRad), Ops::set(0.5));
+            V h = Ops::load(altitudes + i);
+
+            V sinLat, cosLat, sinHalfLon, cosHalfLon;
+            sincos<Ops>(lat, sinLat, cosLat);
+            sincos<Ops>(halfLon, sinHalfLon, cosHalfLon);
+            V sinDLon = Ops::mul(two, Ops::mul(sinHalfLon, cosHalfLon));
+            V cosDLon = Ops::sub(one, Ops::mul(two, Ops::mul(sinHalfLon, sinHalfLon)));
+
+            // Prime vertical radius of curvature
+            V n = Ops::div(Ops::set(st.a),
+                           Ops::sqrt(Ops::sub(one, Ops::mul(Ops::set(st.e2), Ops::mul(sinLat, sinLat)))));
+            V r = Ops::mul(Ops::add(n, h), cosLat);
+
+            V dx = Ops::sub(Ops::mul(r, cosDLon), Ops::set(st.x));
+            V dy = Ops::mul(r, sinDLon);
+            V dz = Ops::sub(Ops::mul(Ops::add(Ops::mul(n, Ops::set(1.0 - st.e2)), h), sinLat), Ops::set(st.z));
+
+            V east = dy;
+            V north = Ops::sub(Ops::mul(cosLat0, dz), Ops::mul(sinLat0, dx));
+            V up = Ops::add(Ops::mul(cosLat0, dx), Ops::mul(sinLat0, dz));
+
+            V horizontal2 = Ops::add(Ops::mul(east, east), Ops::mul(north, north));
+            if (ranges) {
+                Ops::store(ranges + i, Ops::sqrt(Ops::add(horizontal2, Ops::mul(up, up))));
+            }
+
+            if (ANGLES) {
+                if (azimuths) {
+                    Ops::store(azimuths + i, Ops::mul(atan2Full<Ops>(east, north), radToDeg));
+                }
+                if (elevations) {
+                    V el = atan2Positive<Ops>(Ops::abs(up), Ops::sqrt(horizontal2));
+                    el = Ops::select(Ops::lt(up, zero), Ops::sub(zero, el), el);
+                    Ops::store(elevations + i, Ops::mul(el, radToDeg));
+                }
+            }
+        }
+        return i;
+    }
+
+    template<typename Ops>
+    void runLookAngles(const Station& st, const double* lats, const double* lons, const double* altitudes,
+                       size_t count, double* ranges, double* azimuths, double* elevations) {
+        const bool angles = azimuths || elevations;
+        size_t done = angles
+            ? lookAngles<Ops, true>(st, lats, lons, altitudes, count, ranges, azimuths, elevations)
+            : lookAngles<Ops, false>(st, lats, lons, altitudes, count, ranges, nullptr, nullptr);
+        if (done == count) return;
+
+        lats += done;
+        lons += done;
+        altitudes += done;
+        if (ranges) ranges += done;
+        if (azimuths) azimuths += done;
+        if (elevations) elevations += done;
+        if (angles) {
+            lookAngles<ScalarOps, true>(st, lats, lons, altitudes, count - done, ranges, azimuths, elevations);
+        } else {
+            lookAngles<ScalarOps, false>(st, lats, lons, altitudes, count - done, ranges, nullptr, nullptr);
+        }
+    }
+
+    /**
+     * DistanceEngine's trig-free tiers, Ops::WIDTH points per step
+     *
+     * SERIES: haversine with sin, cos and asin replaced by their Taylor
+     * series, valid for latitude and longitude differences up to
+     * seriesLimit; targets beyond it get -1 for the caller to redo.
+     * Otherwise flat earth around the observer. Same arithmetic as the
+     * scalar forms in distanceengine.h.
+     */
+    template<typename Ops, bool SERIES>
+    size_t fastDistance(const Observer& o, const double* lats, const double* lons, size_t count,
+                        double* distances, double seriesLimit) {
+        using V = typename Ops::V;
+        const V degToRad = Ops::set(DEG_TO_RAD);
+        const V one = Ops::set(1.0);
+        const V cosLat0 = Ops::set(o.cosLat);
+
+        size_t i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH) {
+            V dLon = Ops::sub(Ops::load(lons + i), Ops::set(o.lon));
+            dLon = Ops::sub(dLon, Ops::mul(Ops::round(Ops::mul(dLon, Ops::set(1.0 / 360.0))), Ops::set(360.0)));
+            dLon = Ops::mul(dLon, degToRad);
+            V dLat = Ops::mul(Ops::sub(Ops::load(lats + i), Ops::set(o.latDeg)), degToRad);
+            V c;
+
+            if (SERIES) {
+                V p2 = Ops::mul(dLat, dLat);
+                V l2 = Ops::mul(dLon, dLon);
+
+                // 1 - x/12 * (1 - x/30), shared by cos(dLat) and both haversines
+                V tailP = Ops::sub(one, Ops::mul(Ops::mul(p2, Ops::set(1.0 / 12.0)),
+                                                 Ops::sub(one, Ops::mul(p2, Ops::set(1.0 / 30.0)))));
+                V tailL = Ops::sub(one, Ops::mul(Ops::mul(l2, Ops::set(1.0 / 12.0)),
+                                                 Ops::sub(one, Ops::mul(l2, Ops::set(1.0 / 30.0)))));
+                V cosD = Ops::sub(one, Ops::mul(Ops::mul(p2, Ops::set(0.5)), tailP));
+                V sinD = Ops::mul(dLat, Ops::sub(one, Ops::mul(Ops::mul(p2, Ops::set(1.0 / 6.0)),
+                                                               Ops::sub(one, Ops::mul(p2, Ops::set(1.0 / 20.0))))));
+                V cosLat = Ops::sub(Ops::mul(cosLat0, cosD), Ops::mul(Ops::set(o.sinLat), sinD));
+
+                V havLat = Ops::mul(Ops::mul(Ops::set(0.25), p2), tailP);
+                V havLon = Ops::mul(Ops::mul(Ops::set(0.25), l2), tailL);
+                V a = Ops::add(havLat, Ops::mul(Ops::mul(cosLat0, cosLat), havLon));
+                a = Ops::max(a, Ops::set(0.0));
+
+                V asinTail = Ops::add(Ops::set(3.0 / 40.0), Ops::mul(a, Ops::set(5.0 / 112.0)));
+                asinTail = Ops::add(one, Ops::mul(a, Ops::add(Ops::set(1.0 / 6.0), Ops::mul(a, asinTail))));
+                c = Ops::mul(Ops::mul(Ops::set(2.0 * o.radius), Ops::sqrt(a)), asinTail);
+
+                V reach = Ops::max(Ops::abs(dLat), Ops::abs(dLon));
+                c = Ops::select(Ops::gt(reach, Ops::set(seriesLimit)), Ops::set(-1.0), c);
+            } else {
+                V x = Ops::mul(dLon, cosLat0);
+                c = Ops::mul(Ops::sqrt(Ops::add(Ops::mul(x, x), Ops::mul(dLat, dLat))), Ops::set(o.radius));
+            }
+            Ops::store(distances + i, c);
+        }
+        return i;
+    }
+
+    // seriesLimit > 0 selects SERIES
+    template<typename Ops>
+    void runFast(const Observer& o, const double* lats, const double* lons, size_t count,
+                 double* distances, double seriesLimit) {
+        size_t done = seriesLimit > 0.0
+            ? fastDistance<Ops, true>(o, lats, lons, count, distances, seriesLimit)
+            : fastDistance<Ops, false>(o, lats, lons, count, distances, seriesLimit);
+        if (done == count) return;
+
+        lats += done;
+        lons += done;
+        distances += done;
+        if (seriesLimit > 0.0) {
+            fastDistance<ScalarOps, true>(o, lats, lons, count - done, distances, seriesLimit);
+        } else {
+            fastDistance<ScalarOps, false>(o, lats, lons, count - done, distances, seriesLimit);
+        }
+    }
+
+    // Vector body, then the remainder one lane at a time
+    template<typename Ops>
+    void run(const Observer& o, const double* lats, const double* lons, size_t count,
+             double* distances, double* bearings) {
+        size_t done = bearings
+            ? distanceBearing<Ops, true>(o, lats, lons, count, distances, bearings)
+            : distanceBearing<Ops, false>(o, lats, lons, count, distances, bearings);
+        if (done == count) return;
+
+        lats += done;
+        lons += done;
+        distances += done;
+        if (bearings) {
+            distanceBearing<ScalarOps, true>(o, lats, lons, count - done, distances, bearings + done);
+        } else {
+            distanceBearing<ScalarOps, false>(o, lats, lons, count - done, distances, nullptr);
+        }
+    }
+}
+}
+
+#endif // GEOBATCH_H
@@ -1,4 +1,53 @@
 #include "geoutils.h"
+#include "geobatch.h"
 
-// Implementation file for any non-inline functions (currently all inline)
+namespace GeoUtils {
+    BatchKernel bestBatchKernel() {
+#ifdef GEOBATCH_X86_DISPATCH
+        // Also checks that the OS saves the YMM registers
+        static const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if (avx2) return BATCH_AVX2;
+#endif
+#ifdef GEOBATCH_SSE2
+        return BATCH_SSE2;
+#else
+        return BATCH_SCALAR;
+#endif
+    }
 
+    const char* batchKernelName(BatchKernel kernel) {
+        switch (kernel) {
+            case BATCH_AUTO:   return batchKernelName(bestBatchKernel());
+            case BATCH_SCALAR: return "scalar";
+            case BATCH_SSE2:   return "sse2";
+            case BATCH_AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+
+    BatchKernel resolveBatchKernel(BatchKernel kernel) {
+        BatchKernel best = bestBatchKernel();
+        return (kernel == BATCH_AUTO || kernel > best) ? best : kernel;
+    }
+
+    void distanceBearingBatch(double lat, double lon, const double* lats, const double* lons, size_t count,
+                              double* distances, double* bearings, BatchKernel kernel) {
+        switch (resolveBatchKernel(kernel)) {
+#ifdef GEOBATCH_X86_DISPATCH
+            case BATCH_AVX2:
+                distanceBearingBatchAvx2(lat, lon, lats, lons, count, distances, bearings);
+                return;
+#endif
+#ifdef GEOBATCH_SSE2
+            case BATCH_SSE2:
+                GeoBatch::run<GeoBatch::Sse2Ops>(GeoBatch::observer(lat, lon, EARTH_RADIUS), lats, lons, count,
+                                                 distances, bearings);
+                return;
+#endif
+            default:
+                GeoBatch::run<GeoBatch::ScalarOps>(GeoBatch::observer(lat, lon, EARTH_RADIUS), lats, lons, count,
+                                                   distances, bearings);
+                return;
+        }
+    }
+}
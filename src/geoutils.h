@@ -1,7 +1,9 @@
 #ifndef GEOUTILS_H
 #define GEOUTILS_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace GeoUtils {
     constexpr double EARTH_RADIUS = 6371000.0; // meters
@@ -42,6 +44,116 @@ namespace GeoUtils {
         return EARTH_RADIUS * c;
     }
     
+    /**
+     * Latitude/longitude box around a circle on the sphere
+     *
+     * minLon > maxLon means the box wraps across the antimeridian. A box
+     * that reaches a pole spans all longitudes.
+     */
+    struct BoundingBox {
+        double minLat;
+        double maxLat;
+        double minLon;
+        double maxLon;
+        
+        bool wrapsAntimeridian() const { return minLon > maxLon; }
+        
+        bool contains(double lat, double lon) const {
+            if (lat < minLat || lat > maxLat) return false;
+            if (!wrapsAntimeridian()) return lon >= minLon && lon <= maxLon;
+            return lon >= minLon || lon <= maxLon;
+        }
+    };
+    
+    /**
+     * Smallest box containing every point within radius of (lat, lon)
+     *
+     * The longitude half-width is asin(sin(d) / cos(lat)) for the angular
+     * radius d, which widens towards the poles (Matuschek, "Finding Points
+     * Within a Distance of a Latitude/Longitude Using Bounding Coordinates").
+     */
+    inline BoundingBox boundingBox(double lat, double lon, double radius) {
+        double angular = radius / EARTH_RADIUS;
+        BoundingBox box;
+        box.minLat = lat - toDegrees(angular);
+        box.maxLat = lat + toDegrees(angular);
+        
+        if (box.minLat <= -90.0 || box.maxLat >= 90.0) {
+            box.minLat = std::max(box.minLat, -90.0);
+            box.maxLat = std::min(box.maxLat, 90.0);
+            box.minLon = -180.0;
+            box.maxLon = 180.0;
+            return box;
+        }
+        
+        double dLon = toDegrees(std::asin(std::sin(angular) / std::cos(toRadians(lat))));
+        box.minLon = lon - dLon;
+        box.maxLon = lon + dLon;
+        if (box.minLon < -180.0) box.minLon += 360.0;
+        if (box.maxLon > 180.0) box.maxLon -= 360.0;
+        return box;
+    }
+    
+    /**
+     * Membership test for a fixed circle, cheapest test first
+     *
+     * 1. Bounding box: rejects most far-away points with four compares.
+     * 2. Equirectangular distance around the center latitude, squared (no
+     *    trig per point). Its relative error against haversine stays below
+     *    ~0.75 * d * (|tan(lat)| + d) for angular radius d, so points that
+     *    clear the radius by more than that margin are decided here.
+     * 3. Haversine for the thin band near the boundary.
+     *
+     * Near the poles, or for radii where the margin gets large, step 2 is
+     * skipped and every point inside the box gets a haversine.
+     */
+    class RadiusFilter {
+    public:
+        RadiusFilter(double lat, double lon, double radius)
+            : m_lat(lat), m_lon(lon), m_radius(radius),
+              m_box(boundingBox(lat, lon, radius)),
+              m_cosLat(std::cos(toRadians(lat)))
+        {
+            double angular = radius / EARTH_RADIUS;
+            double margin = 0.75 * angular * (std::fabs(std::tan(toRadians(lat))) + angular);
+            bool touchesPole = m_box.minLat <= -90.0 || m_box.maxLat >= 90.0;
+            
+            m_equirectangular = !touchesPole && margin < 0.25;
+            m_innerSq = angular * (1.0 - margin) * angular * (1.0 - margin);
+            m_outerSq = angular * (1.0 + margin) * angular * (1.0 + margin);
+        }
+        
+        const BoundingBox& box() const { return m_box; }
+        
+        bool contains(double lat, double lon) const {
+            if (!m_box.contains(lat, lon)) return false;
+            
+            if (m_equirectangular) {
+                double dLon = lon - m_lon;
+                if (dLon > 180.0) dLon -= 360.0;
+                else if (dLon < -180.0) dLon += 360.0;
+                
+                double x = toRadians(dLon) * m_cosLat;
+                double y = toRadians(lat - m_lat);
+                double d2 = x * x + y * y;
+                if (d2 <= m_innerSq) return true;
+                if (d2 > m_outerSq) return false;
+            }
+            
+            return calculateDistance(m_lat, m_lon, lat, lon) <= m_radius;
+        }
+        
+    private:
+        double m_lat;
+        double m_lon;
+        double m_radius;
+        BoundingBox m_box;
+        double m_cosLat;
+        bool m_equirectangular;
+        double m_innerSq;   // Squared angular radii bounding the undecided band
+        double m_outerSq;
+    };
+    
     /**
      * Calculate bearing (direction) from point 1 to point 2
      * 
@@ -63,9 +175,51 @@ namespace GeoUtils {
         return std::fmod((bearing + 360.0), 360.0);
     }
     
+    /**
+     * Instruction sets for the batch functions below
+     */
+    enum BatchKernel {
+        BATCH_AUTO,     // Best the CPU supports
+        BATCH_SCALAR,
+        BATCH_SSE2,
+        BATCH_AVX2      // AVX2 with FMA, chosen at run time
+    };
+    
+    BatchKernel bestBatchKernel();
+    const char* batchKernelName(BatchKernel kernel);
+    
+    // Kernel a batch function actually runs: BATCH_AUTO and kernels the CPU
+    // lacks become the best one it has
+    BatchKernel resolveBatchKernel(BatchKernel kernel);
+    
+    /**
+     * Distance and bearing from one observer to many points in one pass
+     *
+     * Same formulas as calculateDistance() and calculateBearing(), over
+     * contiguous latitude and longitude arrays (degrees), with sin, cos and
+     * atan evaluated by vectorized polynomials: 4 points per step with AVX2,
+     * 2 with SSE2. Measured against the two scalar functions over a million
+     * random points per kernel, for observers from 89.9°S to 89.9°N, with a
+     * third of the points within a kilometre and a third within 20 m of the
+     * observer: distances agree within 3e-5 m (1e-12 relative), the largest
+     * differences being for observers nearest a pole. Bearings agree within
+     * about 3e-7 / d degrees for a point d meters away (3e-8 degrees at
+     * 10 m), since both formulas lose digits as the points close in; the
+     * bearing of an antipode is undefined. Latitudes must lie within
+     * [-90, 90] and longitudes within [-540, 540].
+     *
+     * @param distances count results in meters
+     * @param bearings  count results in degrees [0, 360), or nullptr for distances only
+     * @param kernel    Instruction set; one the CPU lacks falls back to the best below it
+     */
+    void distanceBearingBatch(double lat, double lon, const double* lats, const double* lons, size_t count,
+                              double* distances, double* bearings, BatchKernel kernel = BATCH_AUTO);
+    
     /**
      * Calculate 3D distance including altitude difference
      * Uses Pythagorean theorem: d = sqrt(horizontal² + vertical²)
+     * Ignores the curvature of the earth; LookAngleEngine gives the true
+     * line-of-sight range
      */
     inline double calculate3DDistance(double lat1, double lon1, double alt1,
                                      double lat2, double lon2, double alt2) {
@@ -78,6 +232,7 @@ namespace GeoUtils {
     /**
      * Calculate elevation angle to target
      * Physics: tan(θ) = opposite/adjacent
+     * Flat ground: too high by about d/(2R) radians at distance d, see LookAngleEngine
      * 
      * @return Elevation angle in degrees (positive = above horizon)
      */
@@ -0,0 +1,56 @@
+// AVX2/FMA instantiation of the batch kernels in geobatch.h
+//
+// Built with the target set by pragma rather than by compiler flags, so no
+// build system needs per-file options. Every header is included before the
+// pragma, except geobatch.h, whose functions have internal linkage: nothing
+// compiled for AVX2 here can replace code that other files call on CPUs
+// without it. Only reached through GeoUtils::distanceBearingBatch() after a
+// CPU check, or through DistanceEngine::distances() and
+// LookAngleEngine::lookAngles() after the same check.
+
+#include "geoutils.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#define GEOBATCH_AVX2
+#include "geobatch.h"
+
+namespace GeoUtils {
+    void distanceBearingBatchAvx2(double lat, double lon, const double* lats, const double* lons,
+                                  size_t count, double* distances, double* bearings) {
+        GeoBatch::run<GeoBatch::Avx2Ops>(GeoBatch::observer(lat, lon, EARTH_RADIUS), lats, lons, count,
+                                         distances, bearings);
+    }
+
+    void fastDistanceBatchAvx2(double lat, double lon, const double* lats, const double* lons,
+                               size_t count, double* distances, double seriesLimit) {
+        GeoBatch::runFast<GeoBatch::Avx2Ops>(GeoBatch::observer(lat, lon, EARTH_RADIUS), lats, lons, count,
+                                             distances, seriesLimit);
+    }
+
+    void lookAnglesBatchAvx2(double lat, double lon, double altitude, double a, double e2,
+                             const double* lats, const double* lons, const double* altitudes, size_t count,
+                             double* ranges, double* azimuths, double* elevations) {
+        GeoBatch::runLookAngles<GeoBatch::Avx2Ops>(GeoBatch::station(lat, lon, altitude, a, e2),
+                                                   lats, lons, altitudes, count, ranges, azimuths, elevations);
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include "gpsnavigator.h"
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QResizeEvent>
 #include <cmath>
 
 GPSNavigator::GPSNavigator(QWidget* parent)
@@ -18,7 +19,7 @@ GPSNavigator::GPSNavigator(QWidget* parent)
       m_currentWaypointIndex(0),
       m_gpsSource(SIMULATED),
       m_gpsLocked(false),
-      m_scale(50.0),
+      m_projection(m_currentLat, m_currentLon, 50.0),
       m_followMode(true),
       m_simSpeed(13.9),  // 50 km/h = 13.9 m/s
       m_simHeading(0.0)
@@ -26,9 +27,6 @@ GPSNavigator::GPSNavigator(QWidget* parent)
     setMinimumSize(800, 600);
     setMouseTracking(true);
     
-    m_centerLat = m_currentLat;
-    m_centerLon = m_currentLon;
-    
     // Initialize system GPS
     m_systemGPS = new SystemGPS(this);
     connect(m_systemGPS, &SystemGPS::positionUpdated, 
@@ -44,8 +42,7 @@ GPSNavigator::GPSNavigator(QWidget* parent)
             m_gpsLocked = true;
             
             if (m_followMode) {
-                m_centerLat = lat;
-                m_centerLon = lon;
+                m_projection.setCenter(lat, lon);
             }
             
             emit locationUpdated(lat, lon);
@@ -75,8 +72,7 @@ void GPSNavigator::setCurrentLocation(double lat, double lon) {
     m_currentLon = lon;
     
     if (m_followMode) {
-        m_centerLat = lat;
-        m_centerLon = lon;
+        m_projection.setCenter(lat, lon);
     }
     
     emit locationUpdated(lat, lon);
@@ -195,18 +191,18 @@ void GPSNavigator::simulateMovement() {
     double bearing = calculateBearingToDestination();
     m_currentHeading = bearing;
     
-    // Move towards destination
+    // Move towards destination on the tangent plane at the current position,
+    // which shrinks east steps by cos(latitude) like the map does
     double distance = m_simSpeed; // Move simSpeed meters per second
-    double dLat = (distance / GeoUtils::EARTH_RADIUS) * std::cos(GeoUtils::toRadians(bearing));
-    double dLon = (distance / GeoUtils::EARTH_RADIUS) * std::sin(GeoUtils::toRadians(bearing));
+    double east = distance * std::sin(GeoUtils::toRadians(bearing));
+    double north = distance * std::cos(GeoUtils::toRadians(bearing));
     
-    m_currentLat += GeoUtils::toDegrees(dLat);
-    m_currentLon += GeoUtils::toDegrees(dLon);
+    MapProjection local(m_currentLat, m_currentLon);
+    local.fromLocal(east, north, m_currentLat, m_currentLon);
     m_currentSpeed = m_simSpeed;
     
     if (m_followMode) {
-        m_centerLat = m_currentLat;
-        m_centerLon = m_currentLon;
+        m_projection.setCenter(m_currentLat, m_currentLon);
     }
     
     emit locationUpdated(m_currentLat, m_currentLon);
@@ -267,11 +263,9 @@ void GPSNavigator::paintEvent(QPaintEvent* event) {
 }
 
 QPointF GPSNavigator::latLonToScreen(double lat, double lon) const {
-    double x = (lon - m_centerLon) * GeoUtils::EARTH_RADIUS * 
-               std::cos(GeoUtils::toRadians(m_centerLat)) / m_scale;
-    double y = -(lat - m_centerLat) * GeoUtils::EARTH_RADIUS / m_scale;
-    
-    return QPointF(width() / 2 + x, height() / 2 + y);
+    double x, y;
+    m_projection.toScreen(lat, lon, x, y);
+    return QPointF(x, y);
 }
 
 void GPSNavigator::drawMap(QPainter& painter) {
@@ -622,14 +616,20 @@ void GPSNavigator::mousePressEvent(QMouseEvent* event) {
 void GPSNavigator::wheelEvent(QWheelEvent* event) {
     // Zoom
     double factor = event->angleDelta().y() > 0 ? 0.8 : 1.25;
-    m_scale *= factor;
+    double scale = m_projection.scale() * factor;
     
-    if (m_scale < 5.0) m_scale = 5.0;
-    if (m_scale > 500.0) m_scale = 500.0;
+    if (scale < 5.0) scale = 5.0;
+    if (scale > 500.0) scale = 500.0;
+    m_projection.setScale(scale);
     
     update();
 }
 
+void GPSNavigator::resizeEvent(QResizeEvent* event) {
+    m_projection.setViewport(event->size().width(), event->size().height());
+    QWidget::resizeEvent(event);
+}
+
 void GPSNavigator::mouseMoveEvent(QMouseEvent* event) {
     Q_UNUSED(event);
     // Could implement panning here
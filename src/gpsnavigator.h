@@ -8,6 +8,7 @@
 #include <QTimer>
 #include <QDateTime>
 #include "geoutils.h"
+#include "mapprojection.h"
 #include "systemgps.h"
 
 struct Waypoint {
@@ -72,6 +73,7 @@ protected:
     void paintEvent(QPaintEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     
 private slots:
@@ -103,9 +105,7 @@ private:
     QDateTime m_lastGPSUpdate;
     
     // Display
-    double m_scale;             // Meters per pixel
-    double m_centerLat;
-    double m_centerLon;
+    MapProjection m_projection; // Center, meters per pixel and viewport
     bool m_followMode;          // Auto-center on current location
     
     // Timers
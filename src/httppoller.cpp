@@ -0,0 +1,161 @@
+#include "httppoller.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <algorithm>
+
+namespace {
+    constexpr int REQUEST_TIMEOUT_MS = 30000;
+    constexpr int MAX_BACKOFF_STEPS = 10;
+
+    // Retry-After is either delta-seconds or an HTTP date; -1 if absent or unparsable
+    int retryAfterMsec(const QNetworkReply* reply) {
+        QByteArray value = reply->rawHeader("Retry-After").trimmed();
+        if (value.isEmpty()) return -1;
+
+        bool ok;
+        int seconds = value.toInt(&ok);
+        if (!ok) {
+            QDateTime when = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+            if (!when.isValid()) return -1;
+            seconds = static_cast<int>(QDateTime::currentDateTimeUtc().secsTo(when));
+        }
+        return std::max(0, seconds) * 1000;
+    }
+}
+
+HttpPoller::HttpPoller(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent),
+      m_manager(manager),
+      m_timer(new QTimer(this)),
+      m_running(false),
+      m_minIntervalMs(5000),
+      m_maxIntervalMs(40000),
+      m_intervalMs(5000),
+      m_errorStreak(0)
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &HttpPoller::pollNow);
+}
+
+HttpPoller::~HttpPoller() {
+    abortReply();
+}
+
+void HttpPoller::setRequest(const QNetworkRequest& request) {
+    if (request.url() != m_request.url()) {
+        resetValidators();
+    }
+    m_request = request;
+}
+
+void HttpPoller::setInterval(int minMsec, int maxMsec) {
+    m_minIntervalMs = minMsec;
+    m_maxIntervalMs = std::max(minMsec, maxMsec);
+    m_intervalMs = minMsec;
+}
+
+void HttpPoller::start() {
+    m_running = true;
+    m_intervalMs = m_minIntervalMs;
+    m_errorStreak = 0;
+    pollNow();
+}
+
+void HttpPoller::stop() {
+    m_running = false;
+    m_timer->stop();
+    abortReply();
+}
+
+void HttpPoller::pollNow() {
+    if (m_reply) {
+        ++m_stats.skipped;
+        return;
+    }
+    if (m_request.url().isEmpty()) return;
+
+    // Accept-Encoding stays unset: QNetworkAccessManager then negotiates
+    // gzip/deflate and hands back the inflated body
+    QNetworkRequest request(m_request);
+    if (!m_etag.isEmpty()) request.setRawHeader("If-None-Match", m_etag);
+    if (!m_lastModified.isEmpty()) request.setRawHeader("If-Modified-Since", m_lastModified);
+    request.setTransferTimeout(REQUEST_TIMEOUT_MS);
+
+    m_timer->stop();
+    ++m_stats.requests;
+    QNetworkReply* reply = m_manager->get(request);
+    m_reply = reply;
+    connect(reply, &QNetworkReply::finished, this, &HttpPoller::handleReply);
+}
+
+void HttpPoller::handleReply() {
+    QNetworkReply* reply = m_reply;
+    m_reply = nullptr;
+    if (!reply) return;
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        ++m_stats.errors;
+        m_errorStreak = std::min(m_errorStreak + 1, MAX_BACKOFF_STEPS);
+
+        int delay = std::min(m_minIntervalMs << m_errorStreak, m_maxIntervalMs);
+        int retryAfter = retryAfterMsec(reply);
+        if (retryAfter >= 0) delay = std::max(delay, retryAfter);
+
+        scheduleNext(delay);
+        emit failed(reply->errorString());
+        return;
+    }
+    m_errorStreak = 0;
+
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 304) {
+        ++m_stats.notModified;
+        m_intervalMs = std::min(m_intervalMs * 3 / 2, m_maxIntervalMs);
+        scheduleNext(m_intervalMs);
+        emit notModified();
+        return;
+    }
+
+    QByteArray body = reply->readAll();
+    m_stats.bytes += static_cast<quint64>(body.size());
+    m_etag = reply->rawHeader("ETag");
+    m_lastModified = reply->rawHeader("Last-Modified");
+
+    // Servers without validators still often serve the same document twice.
+    // A cryptographic digest, so a real update is never mistaken for a repeat.
+    QByteArray digest = QCryptographicHash::hash(body, QCryptographicHash::Sha1);
+    if (digest == m_bodyDigest) {
+        ++m_stats.unchanged;
+        m_intervalMs = std::min(m_intervalMs * 3 / 2, m_maxIntervalMs);
+        scheduleNext(m_intervalMs);
+        emit notModified();
+        return;
+    }
+
+    m_bodyDigest = digest;
+    ++m_stats.modified;
+    m_intervalMs = std::max(m_intervalMs / 2, m_minIntervalMs);
+    scheduleNext(m_intervalMs);
+    emit dataReceived(body);
+}
+
+void HttpPoller::abortReply() {
+    if (!m_reply) return;
+
+    QNetworkReply* reply = m_reply;
+    m_reply = nullptr;
+    disconnect(reply, nullptr, this, nullptr);
+    reply->abort();
+    reply->deleteLater();
+}
+
+void HttpPoller::scheduleNext(int msec) {
+    if (m_running) m_timer->start(msec);
+}
+
+void HttpPoller::resetValidators() {
+    m_etag.clear();
+    m_lastModified.clear();
+    m_bodyDigest.clear();
+}
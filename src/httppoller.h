@@ -0,0 +1,99 @@
+#ifndef HTTPPOLLER_H
+#define HTTPPOLLER_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QByteArray>
+#include <QPointer>
+#include <QTimer>
+
+/**
+ * Periodic HTTP GET of one resource, shared by the polling clients
+ *
+ * - Conditional requests: the ETag and Last-Modified of the last good
+ *   response are sent back as If-None-Match/If-Modified-Since, and a 304 (or
+ *   a body identical to the previous one) is reported as notModified()
+ *   without handing anything to the parser.
+ * - Compression: QNetworkAccessManager advertises gzip/deflate and inflates
+ *   the body itself as long as the request leaves Accept-Encoding unset,
+ *   which the poller guarantees.
+ * - At most one request is in flight. The next poll is only scheduled
+ *   once the reply is finished, so a slow server never sees stacked
+ *   requests; pollNow() during a request is dropped.
+ * - Adaptive interval: data that changed pulls the interval back towards
+ *   the minimum, unchanged data stretches it towards the maximum, and errors
+ *   back off exponentially (a Retry-After header wins).
+ */
+class HttpPoller : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 requests = 0;
+        quint64 modified = 0;       // Bodies handed to dataReceived()
+        quint64 notModified = 0;    // 304 responses
+        quint64 unchanged = 0;      // 200 responses with the previous body
+        quint64 errors = 0;
+        quint64 skipped = 0;        // Polls dropped because a request was in flight
+        quint64 bytes = 0;          // Decoded body bytes
+    };
+
+    HttpPoller(QNetworkAccessManager* manager, QObject* parent = nullptr);
+    ~HttpPoller() override;
+
+    /**
+     * Resource to poll
+     *
+     * Validators from a different URL are discarded. Takes effect with the
+     * next poll; a request already in flight is left to finish.
+     */
+    void setRequest(const QNetworkRequest& request);
+
+    // Interval range (ms); polling starts at and returns to the minimum
+    void setInterval(int minMsec, int maxMsec);
+    void setInterval(int msec) { setInterval(msec, msec * 8); }
+    int currentInterval() const { return m_intervalMs; }
+
+    void start();   // Polls immediately, then adaptively
+    void stop();
+    void pollNow();
+    bool isRunning() const { return m_running; }
+    bool isInFlight() const { return m_reply != nullptr; }
+
+    const Stats& stats() const { return m_stats; }
+
+signals:
+    void dataReceived(const QByteArray& body);
+    void notModified();
+    void failed(const QString& message);
+
+private slots:
+    void handleReply();
+
+private:
+    QNetworkAccessManager* m_manager;
+    QNetworkRequest m_request;
+    QPointer<QNetworkReply> m_reply;    // In-flight request, null when idle
+    QTimer* m_timer;
+    bool m_running;
+
+    int m_minIntervalMs;
+    int m_maxIntervalMs;
+    int m_intervalMs;
+    int m_errorStreak;
+
+    // Validators of the last good response for m_request's URL
+    QByteArray m_etag;
+    QByteArray m_lastModified;
+    QByteArray m_bodyDigest;    // SHA-1 of the last body, empty before the first
+
+    Stats m_stats;
+
+    void abortReply();
+    void scheduleNext(int msec);
+    void resetValidators();
+};
+
+#endif // HTTPPOLLER_H
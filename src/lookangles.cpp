@@ -0,0 +1,99 @@
+#include "lookangles.h"
+#include "geobatch.h"
+#include <cmath>
+
+LookAngleEngine::LookAngleEngine()
+    : LookAngleEngine(0.0, 0.0)
+{
+}
+
+LookAngleEngine::LookAngleEngine(double lat, double lon, double altitude) {
+    setObserver(lat, lon, altitude);
+}
+
+void LookAngleEngine::setObserver(double lat, double lon, double altitude) {
+    m_lat = lat;
+    m_lon = lon;
+    m_altitude = altitude;
+    toEcef(lat, lon, altitude, m_ecef[0], m_ecef[1], m_ecef[2]);
+
+    double sinLat = std::sin(GeoUtils::toRadians(lat));
+    double cosLat = std::cos(GeoUtils::toRadians(lat));
+    double sinLon = std::sin(GeoUtils::toRadians(lon));
+    double cosLon = std::cos(GeoUtils::toRadians(lon));
+
+    // East
+    m_enu[0][0] = -sinLon;
+    m_enu[0][1] = cosLon;
+    m_enu[0][2] = 0.0;
+    // North
+    m_enu[1][0] = -sinLat * cosLon;
+    m_enu[1][1] = -sinLat * sinLon;
+    m_enu[1][2] = cosLat;
+    // Up
+    m_enu[2][0] = cosLat * cosLon;
+    m_enu[2][1] = cosLat * sinLon;
+    m_enu[2][2] = sinLat;
+}
+
+void LookAngleEngine::toEcef(double lat, double lon, double altitude, double& x, double& y, double& z) {
+    double sinLat = std::sin(GeoUtils::toRadians(lat));
+    double cosLat = std::cos(GeoUtils::toRadians(lat));
+    double n = SEMI_MAJOR_AXIS / std::sqrt(1.0 - ECCENTRICITY_SQ * sinLat * sinLat);
+
+    x = (n + altitude) * cosLat * std::cos(GeoUtils::toRadians(lon));
+    y = (n + altitude) * cosLat * std::sin(GeoUtils::toRadians(lon));
+    z = (n * (1.0 - ECCENTRICITY_SQ) + altitude) * sinLat;
+}
+
+void LookAngleEngine::toEnu(double lat, double lon, double altitude,
+                            double& east, double& north, double& up) const {
+    double x, y, z;
+    toEcef(lat, lon, altitude, x, y, z);
+    double dx = x - m_ecef[0];
+    double dy = y - m_ecef[1];
+    double dz = z - m_ecef[2];
+
+    east = m_enu[0][0] * dx + m_enu[0][1] * dy + m_enu[0][2] * dz;
+    north = m_enu[1][0] * dx + m_enu[1][1] * dy + m_enu[1][2] * dz;
+    up = m_enu[2][0] * dx + m_enu[2][1] * dy + m_enu[2][2] * dz;
+}
+
+LookAngleEngine::LookAngle LookAngleEngine::lookAngle(double lat, double lon, double altitude) const {
+    double east, north, up;
+    toEnu(lat, lon, altitude, east, north, up);
+
+    double horizontal = std::sqrt(east * east + north * north);
+    LookAngle look;
+    look.range = std::sqrt(horizontal * horizontal + up * up);
+    look.azimuth = GeoUtils::toDegrees(std::atan2(east, north));
+    if (look.azimuth < 0.0) look.azimuth += 360.0;
+    if (look.azimuth >= 360.0) look.azimuth = 0.0;     // -tiny + 360 rounds up
+    look.elevation = GeoUtils::toDegrees(std::atan2(up, horizontal));
+    return look;
+}
+
+void LookAngleEngine::lookAngles(const double* lats, const double* lons, const double* altitudes, size_t count,
+                                 double* ranges, double* azimuths, double* elevations,
+                                 GeoUtils::BatchKernel kernel) const {
+    switch (GeoUtils::resolveBatchKernel(kernel)) {
+#ifdef GEOBATCH_X86_DISPATCH
+    case GeoUtils::BATCH_AVX2:
+        GeoUtils::lookAnglesBatchAvx2(m_lat, m_lon, m_altitude, SEMI_MAJOR_AXIS, ECCENTRICITY_SQ,
+                                      lats, lons, altitudes, count, ranges, azimuths, elevations);
+        return;
+#endif
+#ifdef GEOBATCH_SSE2
+    case GeoUtils::BATCH_SSE2:
+        GeoBatch::runLookAngles<GeoBatch::Sse2Ops>(
+            GeoBatch::station(m_lat, m_lon, m_altitude, SEMI_MAJOR_AXIS, ECCENTRICITY_SQ),
+            lats, lons, altitudes, count, ranges, azimuths, elevations);
+        return;
+#endif
+    default:
+        GeoBatch::runLookAngles<GeoBatch::ScalarOps>(
+            GeoBatch::station(m_lat, m_lon, m_altitude, SEMI_MAJOR_AXIS, ECCENTRICITY_SQ),
+            lats, lons, altitudes, count, ranges, azimuths, elevations);
+        return;
+    }
+}
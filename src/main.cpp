@@ -1,5 +1,8 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include "mainwindow.h"
+#include "trackerdaemon.h"
+#include <cstring>
 
 int main(int argc, char *argv[]) {
     // Set application info BEFORE creating QApplication
@@ -9,6 +12,13 @@ int main(int argc, char *argv[]) {
     QCoreApplication::setOrganizationName("AeroTracker");
     QCoreApplication::setOrganizationDomain("aerotracker.local");
     
+    // Headless mode must decide before QApplication loads a platform plugin
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return TrackerDaemon::exec(argc, argv);
+        }
+    }
+    
     QApplication app(argc, argv);
     
     // Set Palantir-style dark tactical theme
@@ -126,7 +136,47 @@ int main(int argc, char *argv[]) {
         "}"
     );
     
-    MainWindow window;
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Aircraft and rocket launch tracker");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption headlessOption("headless",
+        "Run the feeds without a user interface; see --headless --help.");
+    QCommandLineOption guiThreadOption("gui-thread",
+        "Keep the data clients on the GUI thread (useful for debugging).");
+    QCommandLineOption recordOption("record",
+        "Record every network feed into <dir>.", "dir");
+    QCommandLineOption replayAircraftOption("replay-aircraft",
+        "Play an ADS-B recording instead of the simulation.", "file");
+    QCommandLineOption replayLaunchesOption("replay-launches",
+        "Play a launch recording instead of the simulation.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay speed: 1 = recorded pace, 0 = as fast as possible.", "factor", "1");
+    QCommandLineOption simAircraftOption("sim-aircraft",
+        "Number of simulated aircraft.", "count", "8");
+    QCommandLineOption simSeedOption("sim-seed",
+        "Seed of the simulated traffic.", "seed", "1");
+    QCommandLineOption simChurnOption("sim-churn",
+        "Share of the simulated fleet that lands and is replaced per hour.", "rate", "0.5");
+    QCommandLineOption simStreamOption("sim-stream",
+        "Feed simulated traffic through the SBS-1 parser as raw messages.");
+    parser.addOptions({headlessOption, guiThreadOption, recordOption, replayAircraftOption,
+                       replayLaunchesOption, replaySpeedOption,
+                       simAircraftOption, simSeedOption, simChurnOption, simStreamOption});
+    parser.process(app);
+    
+    MainWindow::Options options;
+    options.workerThread = !parser.isSet(guiThreadOption);
+    options.recordDir = parser.value(recordOption);
+    options.replayAircraft = parser.value(replayAircraftOption);
+    options.replayLaunches = parser.value(replayLaunchesOption);
+    options.replaySpeed = parser.value(replaySpeedOption).toDouble();
+    options.simulation.aircraft = parser.value(simAircraftOption).toInt();
+    options.simulation.seed = parser.value(simSeedOption).toULongLong();
+    options.simulation.churnPerHour = parser.value(simChurnOption).toDouble();
+    options.simulateStream = parser.isSet(simStreamOption);
+    
+    MainWindow window(options);
     window.show();
     
     return app.exec();
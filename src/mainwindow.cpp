@@ -3,11 +3,52 @@
 #include <QSplitter>
 #include <QStatusBar>
 #include <QTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
 
-MainWindow::MainWindow(QWidget* parent)
+namespace {
+    // Aircraft list items carry their sort key
+    constexpr int DISTANCE_ROLE = Qt::UserRole;
+    constexpr int ADDRESS_ROLE = Qt::UserRole + 1;
+    
+    double itemDistance(const QListWidgetItem* item) {
+        return item->data(DISTANCE_ROLE).toDouble();
+    }
+    
+    uint32_t itemAddress(const QListWidgetItem* item) {
+        return item->data(ADDRESS_ROLE).toUInt();
+    }
+    
+    bool aircraftLessThan(const QListWidgetItem* item, double distance, uint32_t icao) {
+        double d = itemDistance(item);
+        return d < distance || (d == distance && itemAddress(item) < icao);
+    }
+    
+    // Feed label used by AircraftFusion for statistics and errors
+    QString feedName(ADSBClient::Source source) {
+        switch (source) {
+            case ADSBClient::OPENSKY_NETWORK: return "opensky";
+            case ADSBClient::DUMP1090_LOCAL:  return "dump1090";
+            case ADSBClient::BEAST_TCP:       return "beast";
+            case ADSBClient::SBS_TCP:         return "sbs";
+            case ADSBClient::AVR_TCP:         return "avr";
+            case ADSBClient::REPLAY:          return "replay";
+            case ADSBClient::SIMULATED:
+            default:                          return "sim";
+        }
+    }
+}
+
+MainWindow::MainWindow(const Options& options, QWidget* parent)
     : QMainWindow(parent),
+      m_workerThread(nullptr),
+      m_options(options),
       m_userLat(0.0),
-      m_userLon(0.0)
+      m_userLon(0.0),
+      m_fecCorrected(0),
+      m_fecFailed(0)
 {
     setWindowTitle("AETHER // TACTICAL AEROSPACE INTELLIGENCE PLATFORM");
     resize(1600, 1000);
@@ -16,9 +57,28 @@ MainWindow::MainWindow(QWidget* parent)
     setStyleSheet(styleSheet() + 
         "QMainWindow { background-color: #0F1216; }");
     
+    // Deltas and snapshots cross the thread boundary through queued connections
+    qRegisterMetaType<AircraftSnapshot>("AircraftSnapshot");
+    qRegisterMetaType<AircraftDelta>("AircraftDelta");
+    qRegisterMetaType<QVector<Rocket>>("QVector<Rocket>");
+    
     // Initialize clients
-    m_adsbClient = new ADSBClient(this);
-    m_rocketClient = new RocketClient(this);
+    if (m_options.workerThread) {
+        m_workerThread = new QThread(this);
+        m_workerThread->setObjectName("DataClients");
+        
+        m_adsbFeeds = new AircraftFusion();
+        m_rocketClient = new RocketClient();
+        m_adsbFeeds->moveToThread(m_workerThread);
+        m_rocketClient->moveToThread(m_workerThread);
+        connect(m_workerThread, &QThread::finished, m_adsbFeeds, &QObject::deleteLater);
+        connect(m_workerThread, &QThread::finished, m_rocketClient, &QObject::deleteLater);
+        
+        m_workerThread->start();
+    } else {
+        m_adsbFeeds = new AircraftFusion(this);
+        m_rocketClient = new RocketClient(this);
+    }
     
     setupUI();
     setupConnections();
@@ -27,9 +87,28 @@ MainWindow::MainWindow(QWidget* parent)
     // Sync GPS navigator with main location
     m_gpsNavigator->setCurrentLocation(m_userLat, m_userLon);
     
-    // Start tracking
-    m_adsbClient->start();
-    m_rocketClient->start();
+    // Start tracking (timers must be started from the clients' own thread)
+    QString stamp = QDateTime::currentDateTimeUtc().toString("yyyyMMdd-HHmmss");
+    QMetaObject::invokeMethod(m_adsbFeeds, [feeds = m_adsbFeeds, options = m_options]() {
+        feeds->setRecordDirectory(options.recordDir);
+        feeds->setSimulation(options.simulation, options.simulateStream);
+        if (options.replayAircraft.isEmpty()) {
+            feeds->addFeed(feedName(ADSBClient::SIMULATED), ADSBClient::SIMULATED);
+        } else {
+            feeds->addReplayFeed(feedName(ADSBClient::REPLAY), options.replayAircraft, options.replaySpeed);
+        }
+        feeds->start();
+    });
+    QMetaObject::invokeMethod(m_rocketClient, [client = m_rocketClient, options = m_options, stamp]() {
+        if (!options.recordDir.isEmpty()) {
+            client->setRecordFile(QDir(options.recordDir).filePath(QString("launches-%1.rec").arg(stamp)));
+        }
+        if (!options.replayLaunches.isEmpty()) {
+            client->setSource(RocketClient::REPLAY);
+            client->setReplayFile(options.replayLaunches, options.replaySpeed);
+        }
+        client->start();
+    });
     
     // Status update timer
     QTimer* statusTimer = new QTimer(this);
@@ -37,6 +116,24 @@ MainWindow::MainWindow(QWidget* parent)
     statusTimer->start(1000); // Update every second
 }
 
+MainWindow::~MainWindow() {
+    if (m_workerThread) {
+        // The clients are deleted in their own thread once its event loop exits
+        m_workerThread->quit();
+        m_workerThread->wait();
+    }
+}
+
+void MainWindow::setClientLocation(double lat, double lon) {
+    // Queued in worker-thread mode, called directly otherwise
+    QMetaObject::invokeMethod(m_adsbFeeds, [feeds = m_adsbFeeds, lat, lon]() {
+        feeds->setUserLocation(lat, lon);
+    });
+    QMetaObject::invokeMethod(m_rocketClient, [client = m_rocketClient, lat, lon]() {
+        client->setUserLocation(lat, lon);
+    });
+}
+
 void MainWindow::setupUI() {
     QWidget* centralWidget = new QWidget(this);
     setCentralWidget(centralWidget);
@@ -109,11 +206,31 @@ void MainWindow::setupUI() {
     // ADS-B source selection
     QGroupBox* adsbGroup = new QGroupBox("⬢ AEROSPACE TELEMETRY SOURCE");
     QVBoxLayout* adsbLayout = new QVBoxLayout(adsbGroup);
-    m_adsbSourceCombo = new QComboBox();
-    m_adsbSourceCombo->addItem("◉ SIMULATION MODE", ADSBClient::SIMULATED);
-    m_adsbSourceCombo->addItem("◉ OPENSKY NETWORK [LIVE]", ADSBClient::OPENSKY_NETWORK);
-    m_adsbSourceCombo->addItem("◉ DUMP1090 [LOCAL]", ADSBClient::DUMP1090_LOCAL);
-    adsbLayout->addWidget(m_adsbSourceCombo);
+    // Every checked source runs at once; AircraftFusion merges them per aircraft
+    m_adsbSourceList = new QListWidget();
+    QList<QPair<QString, ADSBClient::Source>> adsbSources = {
+        {"◉ SIMULATION MODE", ADSBClient::SIMULATED},
+        {"◉ OPENSKY NETWORK [LIVE]", ADSBClient::OPENSKY_NETWORK},
+        {"◉ DUMP1090 [LOCAL]", ADSBClient::DUMP1090_LOCAL},
+        {"◉ BEAST STREAM [:30005]", ADSBClient::BEAST_TCP},
+        {"◉ SBS-1 STREAM [:30003]", ADSBClient::SBS_TCP},
+        {"◉ AVR RAW FRAMES [:30002]", ADSBClient::AVR_TCP}
+    };
+    // A replay replaces the simulation as the feed running at startup
+    ADSBClient::Source initialSource = ADSBClient::SIMULATED;
+    if (!m_options.replayAircraft.isEmpty()) {
+        adsbSources.append({QString("◉ REPLAY [%1]").arg(QFileInfo(m_options.replayAircraft).fileName()),
+                            ADSBClient::REPLAY});
+        initialSource = ADSBClient::REPLAY;
+    }
+    for (const auto& source : adsbSources) {
+        QListWidgetItem* item = new QListWidgetItem(source.first, m_adsbSourceList);
+        item->setData(Qt::UserRole, source.second);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(source.second == initialSource ? Qt::Checked : Qt::Unchecked);
+    }
+    m_adsbSourceList->setMaximumHeight(m_adsbSourceList->sizeHintForRow(0) * adsbSources.size() + 6);
+    adsbLayout->addWidget(m_adsbSourceList);
     leftLayout->addWidget(adsbGroup);
     
     // Rocket source selection
@@ -122,6 +239,11 @@ void MainWindow::setupUI() {
     m_rocketSourceCombo = new QComboBox();
     m_rocketSourceCombo->addItem("◉ SIMULATION MODE", RocketClient::SIMULATED);
     m_rocketSourceCombo->addItem("◉ LAUNCH LIBRARY [LIVE]", RocketClient::LAUNCH_LIBRARY);
+    if (!m_options.replayLaunches.isEmpty()) {
+        m_rocketSourceCombo->addItem(QString("◉ REPLAY [%1]").arg(QFileInfo(m_options.replayLaunches).fileName()),
+                                     RocketClient::REPLAY);
+        m_rocketSourceCombo->setCurrentIndex(m_rocketSourceCombo->count() - 1);
+    }
     rocketLayout->addWidget(m_rocketSourceCombo);
     leftLayout->addWidget(rocketGroup);
     
@@ -273,8 +395,8 @@ void MainWindow::setupUI() {
             m_userLon = lon;
             m_gpsNavigator->setCurrentLocation(lat, lon);
             m_mapWidget->setUserLocation(lat, lon);
-            m_adsbClient->setUserLocation(lat, lon);
-            m_rocketClient->setUserLocation(lat, lon);
+            setClientLocation(lat, lon);
+            rebuildAircraftList();
             m_latEdit->setText(QString::number(lat, 'f', 6));
             m_lonEdit->setText(QString::number(lon, 'f', 6));
             m_statusLabel->setText(QString("◉ LOCATION SET: [%1°, %2°]").arg(lat, 0, 'f', 4).arg(lon, 0, 'f', 4));
@@ -391,8 +513,11 @@ void MainWindow::setupUI() {
 }
 
 void MainWindow::setupConnections() {
-    connect(m_adsbClient, &ADSBClient::aircraftUpdated,
-            this, &MainWindow::onAircraftUpdated);
+    connect(m_adsbFeeds, &AircraftFusion::aircraftChanged,
+            this, &MainWindow::onAircraftChanged);
+    
+    connect(m_adsbFeeds, &AircraftFusion::errorCorrectionUpdated,
+            this, &MainWindow::onErrorCorrectionUpdated);
     
     connect(m_rocketClient, &RocketClient::rocketsUpdated,
             this, &MainWindow::onRocketsUpdated);
@@ -400,8 +525,8 @@ void MainWindow::setupConnections() {
     connect(m_mapWidget, &MapWidget::proximityAlert,
             this, &MainWindow::onProximityAlert);
     
-    connect(m_adsbSourceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
-            this, &MainWindow::onADSBSourceChanged);
+    connect(m_adsbSourceList, &QListWidget::itemChanged,
+            this, &MainWindow::onADSBSourceToggled);
     
     connect(m_rocketSourceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onRocketSourceChanged);
@@ -451,8 +576,8 @@ void MainWindow::onGPSLocationUpdated(double lat, double lon) {
     m_userLat = lat;
     m_userLon = lon;
     m_mapWidget->setUserLocation(lat, lon);
-    m_adsbClient->setUserLocation(lat, lon);
-    m_rocketClient->setUserLocation(lat, lon);
+    setClientLocation(lat, lon);
+    rebuildAircraftList();
     emit locationUpdated(lat, lon);
 }
 
@@ -465,60 +590,155 @@ void MainWindow::loadDefaultLocation() {
     m_lonEdit->setText(QString::number(m_userLon, 'f', 4));
     
     m_mapWidget->setUserLocation(m_userLat, m_userLon);
-    m_adsbClient->setUserLocation(m_userLat, m_userLon);
-    m_rocketClient->setUserLocation(m_userLat, m_userLon);
+    setClientLocation(m_userLat, m_userLon);
 }
 
-void MainWindow::onAircraftUpdated(const QMap<QString, Aircraft>& aircraft) {
-    m_mapWidget->setAircraft(aircraft);
+void MainWindow::onAircraftChanged(const AircraftDelta& delta) {
+    m_mapWidget->applyAircraftDelta(delta);
     
-    // Update aircraft list
+    // Only rows that moved are touched; the list stays sorted by distance
+    for (const Aircraft& ac : delta.added) {
+        upsertAircraftItem(ac, Aircraft::ALL_FIELDS);
+    }
+    for (const AircraftDelta::Change& change : delta.changed) {
+        upsertAircraftItem(change.aircraft, change.fields);
+    }
+    for (uint32_t icao : delta.removed) {
+        removeAircraftItem(icao);
+    }
+}
+
+void MainWindow::rebuildAircraftList() {
+    // Every distance changes with the user location
     m_aircraftList->clear();
-    
-    QVector<QPair<double, Aircraft>> sortedAircraft;
-    for (const Aircraft& ac : aircraft) {
-        double distance = ac.distanceTo(m_userLat, m_userLon);
-        sortedAircraft.append(qMakePair(distance, ac));
+    m_aircraftItems.clear();
+    
+    const AircraftSnapshot aircraft = m_mapWidget->aircraft();
+    
+    // Sort keys from aircraftDistance() only: per-row updates binary search
+    // with it, so a second formula would leave rows out of order
+    QVector<QListWidgetItem*> items;
+    items.reserve(aircraft->size());
+    for (const Aircraft& ac : *aircraft) {
+        if (!ac.hasPosition()) continue;
+        QListWidgetItem* item = new QListWidgetItem();
+        updateAircraftItem(item, ac, aircraftDistance(ac));
+        items.append(item);
+        m_aircraftItems.insert(ac.getAddress(), item);
     }
     
-    std::sort(sortedAircraft.begin(), sortedAircraft.end(),
-              [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::sort(items.begin(), items.end(), [](QListWidgetItem* a, QListWidgetItem* b) {
+        return aircraftLessThan(a, itemDistance(b), itemAddress(b));
+    });
     
-    for (const auto& pair : sortedAircraft) {
-        const Aircraft& ac = pair.second;
-        double distance = pair.first;
-        
-        QString callsign = ac.getCallsign();
-        if (callsign.isEmpty()) callsign = ac.getICAO();
-        
-        double bearing = GeoUtils::calculateBearing(m_userLat, m_userLon,
-                                                    ac.getLatitude(), ac.getLongitude());
-        
-        QString statusIcon;
-        if (distance < 5000) statusIcon = "◉"; // Critical
-        else if (distance < 15000) statusIcon = "◎"; // Warning
-        else statusIcon = "○"; // Nominal
-        
-        QString text = QString("%1 %2 │ RNG:%3km │ BRG:%4° │ ALT:%5m │ VEL:%6m/s")
-                      .arg(statusIcon)
-                      .arg(callsign, -8)
-                      .arg(distance / 1000.0, 5, 'f', 1)
-                      .arg((int)bearing, 3)
-                      .arg((int)ac.getAltitude(), 5)
-                      .arg((int)ac.getVelocity(), 3);
-        
-        QListWidgetItem* item = new QListWidgetItem(text);
-        if (distance < 5000) {
-            item->setForeground(QColor(255, 82, 82)); // Red for close
-        } else if (distance < 15000) {
-            item->setForeground(QColor(255, 170, 0)); // Orange
-        } else {
-            item->setForeground(QColor(0, 200, 255)); // Cyan
-        }
+    for (QListWidgetItem* item : items) {
         m_aircraftList->addItem(item);
     }
 }
 
+void MainWindow::upsertAircraftItem(const Aircraft& ac, uint32_t fields) {
+    auto it = m_aircraftItems.find(ac.getAddress());
+    
+    if (!ac.hasPosition()) {
+        if (it != m_aircraftItems.end()) removeAircraftItem(ac.getAddress());
+        return;
+    }
+    
+    if (it == m_aircraftItems.end()) {
+        QListWidgetItem* item = new QListWidgetItem();
+        updateAircraftItem(item, ac, aircraftDistance(ac));
+        m_aircraftList->insertItem(aircraftRow(itemDistance(item), ac.getAddress()), item);
+        m_aircraftItems.insert(ac.getAddress(), item);
+        return;
+    }
+    
+    // Heading, vertical rate and squawk are not shown in the list
+    constexpr uint32_t LIST_FIELDS = Aircraft::CALLSIGN | Aircraft::POSITION |
+                                     Aircraft::ALTITUDE | Aircraft::VELOCITY;
+    if (!(fields & LIST_FIELDS)) return;
+    
+    QListWidgetItem* item = it.value();
+    if (fields & Aircraft::POSITION) {
+        // New distance, new row
+        takeAircraftItem(item);
+        updateAircraftItem(item, ac, aircraftDistance(ac));
+        m_aircraftList->insertItem(aircraftRow(itemDistance(item), ac.getAddress()), item);
+    } else {
+        // Same position, so the sort key and row stay as they are
+        updateAircraftItem(item, ac, itemDistance(item));
+    }
+}
+
+void MainWindow::removeAircraftItem(uint32_t icao) {
+    QListWidgetItem* item = m_aircraftItems.take(icao);
+    if (!item) return;
+    delete takeAircraftItem(item);
+}
+
+int MainWindow::aircraftRow(double distance, uint32_t icao) const {
+    // Lower bound on (distance, address); exact row for an item already in the list
+    int lo = 0;
+    int hi = m_aircraftList->count();
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (aircraftLessThan(m_aircraftList->item(mid), distance, icao)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+QListWidgetItem* MainWindow::takeAircraftItem(QListWidgetItem* item) {
+    int row = aircraftRow(itemDistance(item), itemAddress(item));
+    
+    // Only an unsorted list misses; take the item itself, never its neighbour
+    Q_ASSERT(m_aircraftList->item(row) == item);
+    if (m_aircraftList->item(row) != item) row = m_aircraftList->row(item);
+    return m_aircraftList->takeItem(row);
+}
+
+double MainWindow::aircraftDistance(const Aircraft& ac) const {
+    // The list sort key, the same function for every row; DISPLAY precision is plenty
+    return m_mapWidget->distanceEngine().distance(ac.getLatitude(), ac.getLongitude(),
+                                                  DistanceEngine::DISPLAY);
+}
+
+void MainWindow::updateAircraftItem(QListWidgetItem* item, const Aircraft& ac, double distance) {
+    double bearing = GeoUtils::calculateBearing(m_userLat, m_userLon, ac.getLatitude(), ac.getLongitude());
+    
+    QString callsign = ac.getCallsign();
+    if (callsign.isEmpty()) callsign = ac.getICAO();
+    
+    QString statusIcon;
+    if (distance < 5000) statusIcon = "◉"; // Critical
+    else if (distance < 15000) statusIcon = "◎"; // Warning
+    else statusIcon = "○"; // Nominal
+    
+    QString text = QString("%1 %2 │ RNG:%3km │ BRG:%4° │ ALT:%5m │ VEL:%6m/s")
+                  .arg(statusIcon)
+                  .arg(callsign, -8)
+                  .arg(distance / 1000.0, 5, 'f', 1)
+                  .arg((int)bearing, 3)
+                  .arg((int)ac.getAltitude(), 5)
+                  .arg((int)ac.getVelocity(), 3);
+    
+    item->setText(text);
+    item->setData(DISTANCE_ROLE, distance);
+    item->setData(ADDRESS_ROLE, ac.getAddress());
+    
+    if (distance < 5000) {
+        item->setForeground(QColor(255, 82, 82)); // Red for close
+    } else if (distance < 15000) {
+        item->setForeground(QColor(255, 170, 0)); // Orange
+    } else {
+        item->setForeground(QColor(0, 200, 255)); // Cyan
+    }
+}
+
+void MainWindow::onErrorCorrectionUpdated(quint64 corrected, quint64 failed) {
+    m_fecCorrected = corrected;
+    m_fecFailed = failed;
+}
+
 void MainWindow::onRocketsUpdated(const QVector<Rocket>& rockets) {
     m_mapWidget->setRockets(rockets);
     
@@ -573,24 +793,36 @@ void MainWindow::onProximityAlert(const QString& message) {
     msgBox.exec();
 }
 
-void MainWindow::onADSBSourceChanged(int index) {
-    ADSBClient::Source source = static_cast<ADSBClient::Source>(
-        m_adsbSourceCombo->itemData(index).toInt());
-    
-    m_adsbClient->stop();
-    m_adsbClient->setSource(source);
-    m_adsbClient->start();
+void MainWindow::onADSBSourceToggled(QListWidgetItem* item) {
+    ADSBClient::Source source = static_cast<ADSBClient::Source>(item->data(Qt::UserRole).toInt());
+    bool enabled = item->checkState() == Qt::Checked;
+    
+    QMetaObject::invokeMethod(m_adsbFeeds, [feeds = m_adsbFeeds, source, enabled, options = m_options]() {
+        if (enabled && source == ADSBClient::REPLAY) {
+            feeds->addReplayFeed(feedName(source), options.replayAircraft, options.replaySpeed);
+        } else if (enabled) {
+            feeds->addFeed(feedName(source), source);
+        } else {
+            feeds->removeFeed(feedName(source));
+        }
+    });
     
-    m_statusLabel->setText(QString("ADS-B Source: %1").arg(m_adsbSourceCombo->currentText()));
+    m_statusLabel->setText(QString("ADS-B Source %1: %2")
+                          .arg(enabled ? "enabled" : "disabled", item->text()));
 }
 
 void MainWindow::onRocketSourceChanged(int index) {
     RocketClient::Source source = static_cast<RocketClient::Source>(
         m_rocketSourceCombo->itemData(index).toInt());
     
-    m_rocketClient->stop();
-    m_rocketClient->setSource(source);
-    m_rocketClient->start();
+    QMetaObject::invokeMethod(m_rocketClient, [client = m_rocketClient, source, options = m_options]() {
+        client->stop();
+        client->setSource(source);
+        if (source == RocketClient::REPLAY) {
+            client->setReplayFile(options.replayLaunches, options.replaySpeed);
+        }
+        client->start();
+    });
 }
 
 void MainWindow::onLocationChanged() {
@@ -615,8 +847,8 @@ void MainWindow::onLocationChanged() {
     
     m_mapWidget->setUserLocation(m_userLat, m_userLon);
     m_gpsNavigator->setCurrentLocation(m_userLat, m_userLon);
-    m_adsbClient->setUserLocation(m_userLat, m_userLon);
-    m_rocketClient->setUserLocation(m_userLat, m_userLon);
+    setClientLocation(m_userLat, m_userLon);
+    rebuildAircraftList();
     
     emit locationUpdated(m_userLat, m_userLon);
     
@@ -627,12 +859,15 @@ void MainWindow::onLocationChanged() {
 void MainWindow::onAlertDistanceChanged(int value) {
     double meters = value * 1000.0;
     m_mapWidget->setProximityDistance(meters);
-    m_adsbClient->setSearchRadius(meters);
+    QMetaObject::invokeMethod(m_adsbFeeds, [feeds = m_adsbFeeds, meters]() {
+        feeds->setSearchRadius(meters);
+    });
 }
 
 void MainWindow::updateStatus() {
-    int aircraftCount = m_adsbClient->getAircraft().size();
-    int rocketCount = m_rocketClient->getRockets().size();
+    // Snapshots are shared, not copied, and safe to read from the GUI thread
+    int aircraftCount = m_adsbFeeds->getAircraft()->size();
+    int rocketCount = m_rocketClient->getRockets()->size();
     
     QString timestamp = QDateTime::currentDateTime().toString("HH:mm:ss");
     QString status = QString("◉ SYSTEM OPERATIONAL │ TIME:%1 │ CONTACTS:%2 │ LAUNCHES:%3 │ COORDS:[%4°,%5°]")
@@ -642,6 +877,23 @@ void MainWindow::updateStatus() {
                     .arg(m_userLat, 0, 'f', 4)
                     .arg(m_userLon, 0, 'f', 4);
     
+    // Raw frame sources: how many damaged frames the CRC stage saved or dropped
+    if (m_fecCorrected + m_fecFailed > 0) {
+        status += QString(" │ FEC:%1 FIXED/%2 LOST")
+                  .arg(m_fecCorrected)
+                  .arg(m_fecFailed);
+    }
+    
+    // With several sources merged, how many contacts each one currently reports
+    std::shared_ptr<const QVector<AircraftFusion::FeedStats>> feeds = m_adsbFeeds->getFeedStats();
+    if (feeds->size() > 1) {
+        QStringList parts;
+        for (const AircraftFusion::FeedStats& feed : *feeds) {
+            parts << QString("%1:%2").arg(feed.name).arg(feed.aircraft);
+        }
+        status += QString(" │ FEEDS:%1").arg(parts.join(' '));
+    }
+    
     m_statusLabel->setText(status);
 }
 
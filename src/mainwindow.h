@@ -15,23 +15,40 @@
 #include <QTabWidget>
 #include <QScrollArea>
 #include <QCheckBox>
+#include <QThread>
+#include <QHash>
 #include "mapwidget.h"
 #include "gpsnavigator.h"
-#include "adsbclient.h"
+#include "aircraftfusion.h"
 #include "rocketclient.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
     
 public:
-    explicit MainWindow(QWidget* parent = nullptr);
-    ~MainWindow() override = default;
+    struct Options {
+        // Run the data clients (network I/O, parsing, geo filtering) on a worker
+        // thread; the GUI only receives finished snapshots through queued signals
+        bool workerThread = true;
+        
+        QString recordDir;          // Record every network feed into this directory
+        QString replayAircraft;     // ADS-B recording to play instead of the simulation
+        QString replayLaunches;     // Launch recording to play instead of the simulation
+        double replaySpeed = 1.0;   // 0 = as fast as possible
+        
+        TrafficSimulator::Config simulation;
+        bool simulateStream = false;    // Simulated traffic as SBS-1 lines through the parser
+    };
+    
+    explicit MainWindow(const Options& options, QWidget* parent = nullptr);
+    ~MainWindow() override;
     
 private slots:
-    void onAircraftUpdated(const QMap<QString, Aircraft>& aircraft);
+    void onAircraftChanged(const AircraftDelta& delta);
+    void onErrorCorrectionUpdated(quint64 corrected, quint64 failed);
     void onRocketsUpdated(const QVector<Rocket>& rockets);
     void onProximityAlert(const QString& message);
-    void onADSBSourceChanged(int index);
+    void onADSBSourceToggled(QListWidgetItem* item);
     void onRocketSourceChanged(int index);
     void onLocationChanged();
     void onAlertDistanceChanged(int value);
@@ -49,12 +66,23 @@ private:
     void setupUI();
     void setupConnections();
     void loadDefaultLocation();
+    void setClientLocation(double lat, double lon);
+    
+    // Aircraft list, kept sorted by (distance, address) and updated per delta
+    void rebuildAircraftList();
+    void upsertAircraftItem(const Aircraft& ac, uint32_t fields);
+    void removeAircraftItem(uint32_t icao);
+    int aircraftRow(double distance, uint32_t icao) const;
+    QListWidgetItem* takeAircraftItem(QListWidgetItem* item);
+    double aircraftDistance(const Aircraft& ac) const;
+    void updateAircraftItem(QListWidgetItem* item, const Aircraft& ac, double distance);
     
     // UI Components
     QTabWidget* m_tabWidget;
     MapWidget* m_mapWidget;
     GPSNavigator* m_gpsNavigator;
     QListWidget* m_aircraftList;
+    QHash<uint32_t, QListWidgetItem*> m_aircraftItems;
     QListWidget* m_rocketList;
     QLabel* m_statusLabel;
     
@@ -62,7 +90,7 @@ private:
     QLineEdit* m_lonEdit;
     QSpinBox* m_alertDistanceSpin;
     QCheckBox* m_radarSweepCheckbox;
-    QComboBox* m_adsbSourceCombo;
+    QListWidget* m_adsbSourceList;  // One checkable item per feed
     QComboBox* m_rocketSourceCombo;
     QComboBox* m_gpsSourceCombo;
     QPushButton* m_refreshButton;
@@ -73,12 +101,18 @@ private:
     QLineEdit* m_destLonEdit;
     
     // Data clients
-    ADSBClient* m_adsbClient;
+    AircraftFusion* m_adsbFeeds;    // Every enabled ADS-B source, merged
     RocketClient* m_rocketClient;
+    QThread* m_workerThread;    // nullptr when the clients run on the GUI thread
+    Options m_options;
     
     // State
     double m_userLat;
     double m_userLon;
+    
+    // Last error-correction counters reported by the ADS-B feeds
+    quint64 m_fecCorrected;
+    quint64 m_fecFailed;
 };
 
 #endif // MAINWINDOW_H
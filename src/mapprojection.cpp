@@ -0,0 +1,112 @@
+#include "mapprojection.h"
+#include "geoutils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Keeps the east scale finite at the poles
+    constexpr double MIN_COS_LAT = 1e-6;
+}
+
+MapProjection::MapProjection()
+    : MapProjection(0.0, 0.0)
+{
+}
+
+MapProjection::MapProjection(double centerLat, double centerLon, double metersPerPixel,
+                             double width, double height)
+    : m_centerLat(centerLat),
+      m_centerLon(centerLon),
+      m_scale(metersPerPixel),
+      m_width(width),
+      m_height(height)
+{
+    update();
+}
+
+void MapProjection::setCenter(double lat, double lon) {
+    m_centerLat = lat;
+    m_centerLon = lon;
+    update();
+}
+
+void MapProjection::setScale(double metersPerPixel) {
+    m_scale = metersPerPixel;
+    update();
+}
+
+void MapProjection::setViewport(double width, double height) {
+    m_width = width;
+    m_height = height;
+    update();
+}
+
+void MapProjection::update() {
+    double cosLat = std::max(std::cos(GeoUtils::toRadians(m_centerLat)), MIN_COS_LAT);
+
+    m_metersPerDegreeLat = GeoUtils::EARTH_RADIUS * GeoUtils::PI / 180.0;
+    m_metersPerDegreeLon = m_metersPerDegreeLat * cosLat;
+    m_pixelsPerDegreeLat = m_metersPerDegreeLat / m_scale;
+    m_pixelsPerDegreeLon = m_metersPerDegreeLon / m_scale;
+    m_originX = m_width / 2.0;
+    m_originY = m_height / 2.0;
+}
+
+GeoUtils::BoundingBox MapProjection::bounds(double x0, double y0, double x1, double y1) const {
+    GeoUtils::BoundingBox box;
+    box.minLat = std::max(m_centerLat + (m_originY - y1) / m_pixelsPerDegreeLat, -90.0);
+    box.maxLat = std::min(m_centerLat + (m_originY - y0) / m_pixelsPerDegreeLat, 90.0);
+
+    double west = (x0 - m_originX) / m_pixelsPerDegreeLon;
+    double east = (x1 - m_originX) / m_pixelsPerDegreeLon;
+    if (east - west >= 360.0) {
+        box.minLon = -180.0;
+        box.maxLon = 180.0;
+    } else {
+        box.minLon = std::remainder(m_centerLon + west, 360.0);
+        box.maxLon = std::remainder(m_centerLon + east, 360.0);
+    }
+    return box;
+}
+
+// Plain loops over locals: the compiler keeps the constants in registers and vectorizes
+
+void MapProjection::toLocal(const double* lats, const double* lons, size_t count,
+                            double* east, double* north) const {
+    const double lat0 = m_centerLat;
+    const double lon0 = m_centerLon;
+    const double kLat = m_metersPerDegreeLat;
+    const double kLon = m_metersPerDegreeLon;
+    for (size_t i = 0; i < count; ++i) {
+        east[i] = wrapLongitude(lons[i] - lon0) * kLon;
+        north[i] = (lats[i] - lat0) * kLat;
+    }
+}
+
+void MapProjection::toScreen(const double* lats, const double* lons, size_t count,
+                             double* xs, double* ys) const {
+    const double lat0 = m_centerLat;
+    const double lon0 = m_centerLon;
+    const double kLat = m_pixelsPerDegreeLat;
+    const double kLon = m_pixelsPerDegreeLon;
+    const double x0 = m_originX;
+    const double y0 = m_originY;
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = x0 + wrapLongitude(lons[i] - lon0) * kLon;
+        ys[i] = y0 - (lats[i] - lat0) * kLat;
+    }
+}
+
+void MapProjection::fromScreen(const double* xs, const double* ys, size_t count,
+                               double* lats, double* lons) const {
+    const double lat0 = m_centerLat;
+    const double lon0 = m_centerLon;
+    const double kLat = 1.0 / m_pixelsPerDegreeLat;
+    const double kLon = 1.0 / m_pixelsPerDegreeLon;
+    const double x0 = m_originX;
+    const double y0 = m_originY;
+    for (size_t i = 0; i < count; ++i) {
+        lats[i] = lat0 + (y0 - ys[i]) * kLat;
+        lons[i] = wrapLongitude(lon0 + (xs[i] - x0) * kLon);
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef MAPPROJECTION_H
+#define MAPPROJECTION_H
+
+#include "geoutils.h"
+#include <cstddef>
+
+/**
+ * Equirectangular projection on the tangent plane at a center point
+ *
+ * Local coordinates are meters east and north of the center (ENU without
+ * the up axis); screen coordinates are pixels with the center in the middle
+ * of the viewport and y growing downwards. East distances are scaled by the
+ * cosine of the center latitude, so the map is true to scale around the
+ * center; the error grows with the square of the distance from it, about
+ * 0.1% at 100 km in mid latitudes.
+ *
+ * Every constant is computed when the center, scale or viewport changes,
+ * so a transform is a subtraction and a multiplication per axis. Longitude
+ * differences are wrapped, so a center near the antimeridian works.
+ */
+class MapProjection {
+public:
+    MapProjection();
+    MapProjection(double centerLat, double centerLon, double metersPerPixel = 1.0,
+                  double width = 0.0, double height = 0.0);
+
+    void setCenter(double lat, double lon);
+    void setScale(double metersPerPixel);
+    void setViewport(double width, double height);
+
+    double centerLat() const { return m_centerLat; }
+    double centerLon() const { return m_centerLon; }
+    double scale() const { return m_scale; }            // Meters per pixel
+    double width() const { return m_width; }
+    double height() const { return m_height; }
+
+    // Degrees <-> meters east/north of the center
+    void toLocal(double lat, double lon, double& east, double& north) const {
+        east = wrapLongitude(lon - m_centerLon) * m_metersPerDegreeLon;
+        north = (lat - m_centerLat) * m_metersPerDegreeLat;
+    }
+    void fromLocal(double east, double north, double& lat, double& lon) const {
+        lat = m_centerLat + north / m_metersPerDegreeLat;
+        lon = wrapLongitude(m_centerLon + east / m_metersPerDegreeLon);
+    }
+
+    // Degrees <-> pixels
+    void toScreen(double lat, double lon, double& x, double& y) const {
+        x = m_originX + wrapLongitude(lon - m_centerLon) * m_pixelsPerDegreeLon;
+        y = m_originY - (lat - m_centerLat) * m_pixelsPerDegreeLat;
+    }
+    void fromScreen(double x, double y, double& lat, double& lon) const {
+        lat = m_centerLat + (m_originY - y) / m_pixelsPerDegreeLat;
+        lon = wrapLongitude(m_centerLon + (x - m_originX) / m_pixelsPerDegreeLon);
+    }
+
+    /**
+     * Latitude/longitude box shown by the screen rectangle (x0, y0)-(x1, y1)
+     *
+     * Screen x and y are linear in longitude and latitude, so the rectangle
+     * maps onto the box exactly. Latitudes are clamped to the poles, and a
+     * rectangle more than a turn wide spans all longitudes.
+     */
+    GeoUtils::BoundingBox bounds(double x0, double y0, double x1, double y1) const;
+
+    // The same over arrays; input and output may not overlap
+    void toLocal(const double* lats, const double* lons, size_t count, double* east, double* north) const;
+    void toScreen(const double* lats, const double* lons, size_t count, double* xs, double* ys) const;
+    void fromScreen(const double* xs, const double* ys, size_t count, double* lats, double* lons) const;
+
+    // Degrees into [-180, 180], for inputs within one turn of it
+    static double wrapLongitude(double lon) {
+        return lon > 180.0 ? lon - 360.0 : (lon < -180.0 ? lon + 360.0 : lon);
+    }
+
+private:
+    double m_centerLat;         // degrees
+    double m_centerLon;
+    double m_scale;             // meters per pixel
+    double m_width;             // pixels
+    double m_height;
+
+    // Derived
+    double m_metersPerDegreeLat;
+    double m_metersPerDegreeLon;
+    double m_pixelsPerDegreeLat;
+    double m_pixelsPerDegreeLon;
+    double m_originX;           // Screen position of the center
+    double m_originY;
+
+    void update();
+};
+
+#endif // MAPPROJECTION_H
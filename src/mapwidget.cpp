@@ -3,17 +3,18 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QResizeEvent>
 #include <cmath>
 
 MapWidget::MapWidget(QWidget* parent)
     : QWidget(parent),
       m_userLat(0.0),
       m_userLon(0.0),
-      m_scale(100.0),  // Start at 100 meters per pixel
-      m_centerLat(0.0),
-      m_centerLon(0.0),
+      m_aircraft(std::make_shared<const AircraftTable>()),
+      m_projection(0.0, 0.0, 100.0),  // Start at 100 meters per pixel
       m_proximityAlertEnabled(true),
       m_proximityDistance(10000.0), // 10 km default
+      m_selectedIcao(Aircraft::NO_ADDRESS),
       m_radarSweepEnabled(true),
       m_sweepAngle(0.0),
       m_sweepRPM(6) // 6 RPM = 1 revolution per 10 seconds
@@ -30,17 +31,124 @@ MapWidget::MapWidget(QWidget* parent)
 void MapWidget::setUserLocation(double lat, double lon) {
     m_userLat = lat;
     m_userLon = lon;
-    m_centerLat = lat;
-    m_centerLon = lon;
+    m_projection.setCenter(lat, lon);
+    m_distanceEngine.setObserver(lat, lon);
+    m_lookAngles.setObserver(lat, lon);
+    updateRanges();
     update();
 }
 
-void MapWidget::setAircraft(const QMap<QString, Aircraft>& aircraft) {
+void MapWidget::setAircraft(const AircraftSnapshot& aircraft) {
     m_aircraft = aircraft;
+    updateRanges();
+    
+    m_tracks.clear();
+    m_spatialIndex.clear();
+    for (const Aircraft& ac : *m_aircraft) {
+        recordTrack(ac);
+        indexAircraft(ac);
+    }
+    
     checkProximityAlerts();
     update();
 }
 
+void MapWidget::applyAircraftDelta(const AircraftDelta& delta) {
+    m_aircraft = delta.snapshot;
+    updateRanges(delta);
+    
+    // Only aircraft that appeared or moved can cross the alert radius
+    for (const Aircraft& ac : delta.added) {
+        recordTrack(ac);
+        indexAircraft(ac);
+        checkAircraftProximity(ac, m_distanceEngine.within(ac.getLatitude(), ac.getLongitude(),
+                                                           m_proximityDistance));
+    }
+    for (const AircraftDelta::Change& change : delta.changed) {
+        if (change.fields & Aircraft::POSITION) {
+            const Aircraft& ac = change.aircraft;
+            recordTrack(ac);
+            indexAircraft(ac);
+            checkAircraftProximity(ac, m_distanceEngine.within(ac.getLatitude(), ac.getLongitude(),
+                                                               m_proximityDistance));
+        }
+    }
+    
+    for (uint32_t icao : delta.removed) {
+        m_tracks.remove(icao);
+        m_spatialIndex.remove(icao);
+        m_alertedAircraft.remove(icao);
+        if (icao == m_selectedIcao) m_selectedIcao = Aircraft::NO_ADDRESS;
+    }
+    
+    checkRocketProximity();
+    update();
+}
+
+void MapWidget::updateRanges() {
+    // A new observer or a new table changes every range: the whole fleet in
+    // one batch pass; colour bands and labels need no more than DISPLAY
+    m_ranges.clear();
+    for (const Aircraft& ac : *m_aircraft) {
+        queueRange(ac);
+    }
+    computeRanges();
+}
+
+void MapWidget::updateRanges(const AircraftDelta& delta) {
+    // Only aircraft that appeared or moved; the rest keep theirs
+    for (const Aircraft& ac : delta.added) {
+        queueRange(ac);
+    }
+    for (const AircraftDelta::Change& change : delta.changed) {
+        if (change.fields & Aircraft::POSITION) queueRange(change.aircraft);
+    }
+    for (uint32_t icao : delta.removed) {
+        m_ranges.remove(icao);
+    }
+    computeRanges();
+}
+
+void MapWidget::queueRange(const Aircraft& aircraft) {
+    if (!aircraft.hasPosition()) {
+        m_ranges.remove(aircraft.getAddress());
+        return;
+    }
+    m_rangeIds.append(aircraft.getAddress());
+    m_rangeLats.append(aircraft.getLatitude());
+    m_rangeLons.append(aircraft.getLongitude());
+}
+
+void MapWidget::computeRanges() {
+    const int count = m_rangeIds.size();
+    m_rangeOut.resize(count);
+    m_distanceEngine.distances(m_rangeLats.constData(), m_rangeLons.constData(), static_cast<size_t>(count),
+                               m_rangeOut.data(), DistanceEngine::DISPLAY);
+    
+    for (int i = 0; i < count; ++i) {
+        m_ranges.insert(m_rangeIds[i], m_rangeOut[i]);
+    }
+    
+    // Keeps the capacity for the next batch
+    m_rangeIds.resize(0);
+    m_rangeLats.resize(0);
+    m_rangeLons.resize(0);
+}
+
+void MapWidget::recordTrack(const Aircraft& aircraft) {
+    if (!aircraft.hasPosition()) return;
+    
+    TrackHistory::Point point;
+    // The fix time: last-seen also moves with messages that carry no position
+    point.timeMs = aircraft.getPositionTime() / MonotonicClock::NS_PER_MS;
+    point.lat = aircraft.getLatitude();
+    point.lon = aircraft.getLongitude();
+    point.altitude = static_cast<float>(aircraft.getAltitude());
+    point.speed = static_cast<float>(aircraft.getVelocity());
+    point.heading = static_cast<float>(aircraft.getHeading());
+    m_tracks.append(aircraft.getAddress(), point);
+}
+
 void MapWidget::setRockets(const QVector<Rocket>& rockets) {
     m_rockets = rockets;
     update();
@@ -75,7 +183,7 @@ void MapWidget::paintEvent(QPaintEvent* event) {
     }
     
     // Draw tactical range circles
-    QPointF center = latLonToScreen(m_centerLat, m_centerLon);
+    QPointF center = latLonToScreen(m_projection.centerLat(), m_projection.centerLon());
     QVector<double> ranges = {5000, 10000, 25000, 50000}; // meters
     QVector<QColor> rangeColors = {
         QColor(255, 82, 82, 80),   // Red - critical range
@@ -85,7 +193,7 @@ void MapWidget::paintEvent(QPaintEvent* event) {
     };
     
     for (int i = 0; i < ranges.size(); ++i) {
-        double radius = ranges[i] / m_scale;
+        double radius = ranges[i] / m_projection.scale();
         painter.setPen(QPen(rangeColors[i], 2));
         painter.drawEllipse(center, radius, radius);
     }
@@ -100,13 +208,17 @@ void MapWidget::paintEvent(QPaintEvent* event) {
 }
 
 QPointF MapWidget::latLonToScreen(double lat, double lon) const {
-    // Simple equirectangular projection
-    // More accurate for small areas
-    double x = (lon - m_centerLon) * GeoUtils::EARTH_RADIUS * 
-               std::cos(GeoUtils::toRadians(m_centerLat)) / m_scale;
-    double y = -(lat - m_centerLat) * GeoUtils::EARTH_RADIUS / m_scale;
-    
-    return QPointF(width() / 2 + x, height() / 2 + y);
+    double x, y;
+    m_projection.toScreen(lat, lon, x, y);
+    return QPointF(x, y);
+}
+
+void MapWidget::indexAircraft(const Aircraft& aircraft) {
+    if (aircraft.hasPosition()) {
+        m_spatialIndex.update(aircraft.getAddress(), aircraft.getLatitude(), aircraft.getLongitude());
+    } else {
+        m_spatialIndex.remove(aircraft.getAddress());
+    }
 }
 
 void MapWidget::drawUser(QPainter& painter) {
@@ -136,13 +248,62 @@ void MapWidget::drawUser(QPainter& painter) {
     painter.drawText(pos.x() + 18, pos.y() - 6, "◉ OBSERVATION POINT");
 }
 
+void MapWidget::drawTrails(QPainter& painter) {
+    painter.save();
+    painter.setBrush(Qt::NoBrush);
+    
+    for (const Aircraft& aircraft : *m_aircraft) {
+        const TrackHistory::Track* track = m_tracks.find(aircraft.getAddress());
+        if (!track || track->size() < 2) continue;
+        
+        // Fade from transparent at the oldest point to solid at the newest
+        QPointF prev = latLonToScreen(track->at(0).lat, track->at(0).lon);
+        for (int i = 1; i < track->size(); ++i) {
+            QPointF next = latLonToScreen(track->at(i).lat, track->at(i).lon);
+            int alpha = 30 + 170 * i / (track->size() - 1);
+            painter.setPen(QPen(QColor(0, 200, 255, alpha), 1.5));
+            painter.drawLine(prev, next);
+            prev = next;
+        }
+    }
+    
+    painter.restore();
+}
+
 void MapWidget::drawAircraft(QPainter& painter) {
-    for (const Aircraft& aircraft : m_aircraft) {
+    drawTrails(painter);
+    
+    // Only aircraft on screen, with a margin so labels of those just off the
+    // left or top edge still show
+    const double margin = 100.0; // pixels
+    m_queryIds.clear();
+    m_spatialIndex.queryBox(m_projection.bounds(-margin, -margin, width() + margin, height() + margin),
+                            m_queryIds);
+    
+    // Elevation labels only for what is drawn, in one batch
+    m_drawn.resize(0);
+    for (uint32_t icao : m_queryIds) {
+        const Aircraft* aircraft = m_aircraft->find(icao);
+        if (!aircraft) continue;
+        m_drawn.append(aircraft);
+        m_rangeLats.append(aircraft->getLatitude());
+        m_rangeLons.append(aircraft->getLongitude());
+        m_rangeAlts.append(aircraft->getAltitude());
+    }
+    const int count = m_drawn.size();
+    m_elevations.resize(count);
+    m_lookAngles.lookAngles(m_rangeLats.constData(), m_rangeLons.constData(), m_rangeAlts.constData(),
+                            static_cast<size_t>(count), nullptr, nullptr, m_elevations.data());
+    m_rangeLats.resize(0);
+    m_rangeLons.resize(0);
+    m_rangeAlts.resize(0);
+    
+    for (int i = 0; i < count; ++i) {
+        const Aircraft& aircraft = *m_drawn[i];
+        double distance = m_ranges.value(aircraft.getAddress());   // From the user, see updateRanges()
+        double elevation = m_elevations[i];
         QPointF pos = latLonToScreen(aircraft.getLatitude(), aircraft.getLongitude());
         
-        // Calculate distance from user
-        double distance = aircraft.distanceTo(m_userLat, m_userLon);
-        
         // Color based on distance
         QColor color;
         if (distance < 5000) {
@@ -154,7 +315,7 @@ void MapWidget::drawAircraft(QPainter& painter) {
         }
         
         // Highlight if selected
-        if (aircraft.getICAO() == m_selectedIcao) {
+        if (aircraft.getAddress() == m_selectedIcao) {
             painter.setPen(QPen(Qt::yellow, 3));
             painter.setBrush(Qt::NoBrush);
             painter.drawEllipse(pos, 20, 20);
@@ -189,6 +350,8 @@ void MapWidget::drawAircraft(QPainter& painter) {
                         QString("RNG:%1km").arg(distance / 1000.0, 0, 'f', 1));
         painter.drawText(pos.x() + 10, pos.y() + 13,
                         QString("ALT:%1m").arg((int)aircraft.getAltitude()));
+        painter.drawText(pos.x() + 10, pos.y() + 23,
+                        QString("ELV:%1°").arg(elevation, 0, 'f', 1));
     }
 }
 
@@ -297,10 +460,11 @@ void MapWidget::drawScale(QPainter& painter) {
     
     // Scale bar
     double scaleLength = 10000.0; // 10 km
-    if (m_scale > 200) scaleLength = 50000.0; // 50 km
-    else if (m_scale < 50) scaleLength = 5000.0; // 5 km
+    double scale = m_projection.scale();
+    if (scale > 200) scaleLength = 50000.0; // 50 km
+    else if (scale < 50) scaleLength = 5000.0; // 5 km
     
-    int barWidth = scaleLength / m_scale;
+    int barWidth = scaleLength / scale;
     
     painter.setPen(QPen(Qt::white, 2));
     painter.drawLine(x, y, x + barWidth, y);
@@ -341,11 +505,11 @@ void MapWidget::drawInfo(QPainter& painter) {
     
     // Aircraft count with status indicator
     QString aircraftStatus;
-    if (m_aircraft.size() == 0) aircraftStatus = "○ NO CONTACTS";
-    else if (m_aircraft.size() < 5) aircraftStatus = QString("◎ %1 CONTACTS").arg(m_aircraft.size());
-    else aircraftStatus = QString("◉ %1 CONTACTS").arg(m_aircraft.size());
+    if (m_aircraft->size() == 0) aircraftStatus = "○ NO CONTACTS";
+    else if (m_aircraft->size() < 5) aircraftStatus = QString("◎ %1 CONTACTS").arg(m_aircraft->size());
+    else aircraftStatus = QString("◉ %1 CONTACTS").arg(m_aircraft->size());
     
-    painter.setPen(m_aircraft.size() > 10 ? QColor(255, 82, 82) : QColor(0, 255, 128));
+    painter.setPen(m_aircraft->size() > 10 ? QColor(255, 82, 82) : QColor(0, 255, 128));
     painter.drawText(x + 10, y + 64, QString("AERIAL TARGETS: %1").arg(aircraftStatus));
     
     // Rockets count
@@ -373,7 +537,7 @@ void MapWidget::drawInfo(QPainter& painter) {
     // Scale info
     painter.drawText(x + 10, y + 128,
                      QString("MAP SCALE: 1px = %1m")
-                     .arg(m_scale, 0, 'f', 0));
+                     .arg(m_projection.scale(), 0, 'f', 0));
     
     // Instructions
     painter.setFont(QFont("Consolas", 8));
@@ -385,33 +549,61 @@ void MapWidget::drawInfo(QPainter& painter) {
 void MapWidget::checkProximityAlerts() {
     if (!m_proximityAlertEnabled) return;
     
-    for (const Aircraft& aircraft : m_aircraft) {
-        double distance = aircraft.distanceTo(m_userLat, m_userLon);
-        
-        if (distance < m_proximityDistance) {
-            QString icao = aircraft.getICAO();
-            if (!m_alertedAircraft.contains(icao)) {
-                m_alertedAircraft.insert(icao);
-                
-                QString callsign = aircraft.getCallsign();
-                if (callsign.isEmpty()) callsign = icao;
-                
-                double bearing = GeoUtils::calculateBearing(m_userLat, m_userLon,
-                                                           aircraft.getLatitude(),
-                                                           aircraft.getLongitude());
-                
-                QString message = QString("✈ Aircraft Nearby!\n%1\nDistance: %2 km\nBearing: %3°\nAltitude: %4 m")
-                                 .arg(callsign)
-                                 .arg(distance / 1000.0, 0, 'f', 2)
-                                 .arg(bearing, 0, 'f', 0)
-                                 .arg(aircraft.getAltitude(), 0, 'f', 0);
-                
-                emit proximityAlert(message);
-            }
-        } else {
-            m_alertedAircraft.remove(aircraft.getICAO());
+    // Aircraft inside the radius may raise an alert, the rest only rearm theirs
+    m_queryIds.clear();
+    m_spatialIndex.queryRadius(m_userLat, m_userLon, m_proximityDistance, m_queryIds);
+    QSet<uint32_t> nearby;
+    for (uint32_t icao : m_queryIds) {
+        const Aircraft* aircraft = m_aircraft->find(icao);
+        if (!aircraft) continue;
+        nearby.insert(icao);
+        checkAircraftProximity(*aircraft, true);
+    }
+    m_alertedAircraft.intersect(nearby);
+    
+    checkRocketProximity();
+}
+
+void MapWidget::checkAircraftProximity(const Aircraft& aircraft, bool nearby) {
+    if (!m_proximityAlertEnabled || !aircraft.hasPosition()) return;
+    
+    if (nearby) {
+        if (!m_alertedAircraft.contains(aircraft.getAddress())) {
+            m_alertedAircraft.insert(aircraft.getAddress());
+            
+            // Reported to the user, so the exact figure
+            double distance = m_distanceEngine.distance(aircraft.getLatitude(), aircraft.getLongitude(),
+                                                        DistanceEngine::EXACT);
+            QString callsign = aircraft.getCallsign();
+            if (callsign.isEmpty()) callsign = aircraft.getICAO();
+            
+            double bearing = GeoUtils::calculateBearing(m_userLat, m_userLon,
+                                                       aircraft.getLatitude(),
+                                                       aircraft.getLongitude());
+            
+            // Where to look: line of sight over the curved earth
+            LookAngleEngine::LookAngle look = m_lookAngles.lookAngle(aircraft.getLatitude(),
+                                                                     aircraft.getLongitude(),
+                                                                     aircraft.getAltitude());
+            
+            QString message = QString("✈ Aircraft Nearby!\n%1\nDistance: %2 km\nBearing: %3°\nAltitude: %4 m\n"
+                                      "Elevation: %5° (slant range %6 km)")
+                             .arg(callsign)
+                             .arg(distance / 1000.0, 0, 'f', 2)
+                             .arg(bearing, 0, 'f', 0)
+                             .arg(aircraft.getAltitude(), 0, 'f', 0)
+                             .arg(look.elevation, 0, 'f', 1)
+                             .arg(look.range / 1000.0, 0, 'f', 2);
+            
+            emit proximityAlert(message);
         }
+    } else {
+        m_alertedAircraft.remove(aircraft.getAddress());
     }
+}
+
+void MapWidget::checkRocketProximity() {
+    if (!m_proximityAlertEnabled) return;
     
     // Check rocket launch proximity
     for (const Rocket& rocket : m_rockets) {
@@ -422,9 +614,9 @@ void MapWidget::checkProximityAlerts() {
         
         // Alert if launch is within 1 hour and within 200 km
         if (timeToLaunch > 0 && timeToLaunch < 3600 && distance < 200000) {
-            QString id = "ROCKET_" + rocket.getId();
-            if (!m_alertedAircraft.contains(id)) {
-                m_alertedAircraft.insert(id);
+            QString id = rocket.getId();
+            if (!m_alertedRockets.contains(id)) {
+                m_alertedRockets.insert(id);
                 
                 QString message = QString("🚀 ROCKET LAUNCH IMMINENT!\n%1\n%2\nDistance: %3 km")
                                  .arg(rocket.getName())
@@ -441,16 +633,26 @@ void MapWidget::mousePressEvent(QMouseEvent* event) {
     QPointF clickPos = event->pos();
     
     // Check if clicked on aircraft
-    m_selectedIcao.clear();
+    m_selectedIcao = Aircraft::NO_ADDRESS;
     double minDist = 20.0; // pixels
     
-    for (const Aircraft& aircraft : m_aircraft) {
+    // Candidates within the pick radius on either axis
+    m_queryIds.clear();
+    m_spatialIndex.queryBox(m_projection.bounds(clickPos.x() - minDist, clickPos.y() - minDist,
+                                                clickPos.x() + minDist, clickPos.y() + minDist),
+                            m_queryIds);
+    
+    for (uint32_t icao : m_queryIds) {
+        const Aircraft* found = m_aircraft->find(icao);
+        if (!found) continue;
+        const Aircraft& aircraft = *found;
+        
         QPointF pos = latLonToScreen(aircraft.getLatitude(), aircraft.getLongitude());
         double dist = std::sqrt(std::pow(pos.x() - clickPos.x(), 2) + 
                                std::pow(pos.y() - clickPos.y(), 2));
         
         if (dist < minDist) {
-            m_selectedIcao = aircraft.getICAO();
+            m_selectedIcao = aircraft.getAddress();
             minDist = dist;
         }
     }
@@ -461,15 +663,21 @@ void MapWidget::mousePressEvent(QMouseEvent* event) {
 void MapWidget::wheelEvent(QWheelEvent* event) {
     // Zoom in/out
     double factor = event->angleDelta().y() > 0 ? 0.8 : 1.25;
-    m_scale *= factor;
+    double scale = m_projection.scale() * factor;
     
     // Clamp scale
-    if (m_scale < 10.0) m_scale = 10.0;
-    if (m_scale > 1000.0) m_scale = 1000.0;
+    if (scale < 10.0) scale = 10.0;
+    if (scale > 1000.0) scale = 1000.0;
+    m_projection.setScale(scale);
     
     update();
 }
 
+void MapWidget::resizeEvent(QResizeEvent* event) {
+    m_projection.setViewport(event->size().width(), event->size().height());
+    QWidget::resizeEvent(event);
+}
+
 void MapWidget::mouseMoveEvent(QMouseEvent* event) {
     Q_UNUSED(event);
     // Could implement panning here
@@ -505,7 +713,7 @@ void MapWidget::updateRadarSweep() {
 void MapWidget::drawRadarSweep(QPainter& painter) {
     if (!m_radarSweepEnabled) return;
     
-    QPointF center = latLonToScreen(m_centerLat, m_centerLon);
+    QPointF center = latLonToScreen(m_projection.centerLat(), m_projection.centerLon());
     
     // Calculate maximum radius (to edge of screen)
     double maxRadius = std::sqrt(std::pow(width() / 2.0, 2) + std::pow(height() / 2.0, 2));
@@ -2,11 +2,20 @@
 #define MAPWIDGET_H
 
 #include <QWidget>
-#include <QMap>
+#include <QSet>
+#include <QHash>
 #include <QVector>
 #include <QTimer>
+#include <vector>
 #include "aircraft.h"
+#include "aircrafttable.h"
+#include "aircraftdelta.h"
+#include "mapprojection.h"
+#include "distanceengine.h"
+#include "lookangles.h"
+#include "spatialindex.h"
 #include "rocket.h"
+#include "trackhistory.h"
 
 class MapWidget : public QWidget {
     Q_OBJECT
@@ -16,7 +25,11 @@ public:
     ~MapWidget() override = default;
     
     void setUserLocation(double lat, double lon);
-    void setAircraft(const QMap<QString, Aircraft>& aircraft);
+    void setAircraft(const AircraftSnapshot& aircraft);
+    void applyAircraftDelta(const AircraftDelta& delta);
+    const AircraftSnapshot& aircraft() const { return m_aircraft; }
+    const TrackHistory& tracks() const { return m_tracks; }
+    const DistanceEngine& distanceEngine() const { return m_distanceEngine; }   // From the user location
     void setRockets(const QVector<Rocket>& rockets);
     void setProximityAlert(bool enabled) { m_proximityAlertEnabled = enabled; }
     void setProximityDistance(double meters) { m_proximityDistance = meters; }
@@ -30,6 +43,7 @@ protected:
     void paintEvent(QPaintEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     
 private slots:
@@ -38,18 +52,30 @@ private slots:
 private:
     double m_userLat;
     double m_userLon;
-    QMap<QString, Aircraft> m_aircraft;
+    AircraftSnapshot m_aircraft;    // Shared with the client, never null
+    DistanceEngine m_distanceEngine;
+    QHash<uint32_t, double> m_ranges;       // DISPLAY distance from the user per aircraft with a position
+    LookAngleEngine m_lookAngles;
+    QVector<const Aircraft*> m_drawn;   // Aircraft in the viewport, filled while painting
+    QVector<double> m_elevations;   // Degrees above the user's horizon, same order
+    QVector<uint32_t> m_rangeIds;   // Batch input, reused
+    QVector<double> m_rangeLats;
+    QVector<double> m_rangeLons;
+    QVector<double> m_rangeAlts;
+    QVector<double> m_rangeOut;     // Batch output, reused
+    SpatialIndex m_spatialIndex;    // Positions of m_aircraft, updated per delta
+    std::vector<uint32_t> m_queryIds;   // Index query results, reused
+    TrackHistory m_tracks;          // Recent positions for trails
     QVector<Rocket> m_rockets;
     
-    double m_scale;             // Meters per pixel
-    double m_centerLat;
-    double m_centerLon;
+    MapProjection m_projection; // Center, meters per pixel and viewport
     
     bool m_proximityAlertEnabled;
     double m_proximityDistance; // meters
-    QSet<QString> m_alertedAircraft;
+    QSet<uint32_t> m_alertedAircraft;
+    QSet<QString> m_alertedRockets;
     
-    QString m_selectedIcao;
+    uint32_t m_selectedIcao;    // Aircraft::NO_ADDRESS when nothing is selected
     
     // Radar sweep animation
     bool m_radarSweepEnabled;
@@ -62,11 +88,20 @@ private:
     void drawScale(QPainter& painter);
     void drawUser(QPainter& painter);
     void drawAircraft(QPainter& painter);
+    void drawTrails(QPainter& painter);
     void drawRockets(QPainter& painter);
     void drawInfo(QPainter& painter);
     void drawRadarSweep(QPainter& painter);
     
+    void updateRanges();
+    void updateRanges(const AircraftDelta& delta);
+    void queueRange(const Aircraft& aircraft);
+    void computeRanges();
     void checkProximityAlerts();
+    void checkAircraftProximity(const Aircraft& aircraft, bool nearby);
+    void checkRocketProximity();
+    void recordTrack(const Aircraft& aircraft);
+    void indexAircraft(const Aircraft& aircraft);
 };
 
 #endif // MAPWIDGET_H
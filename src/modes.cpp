@@ -0,0 +1,315 @@
+#include "modes.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace {
+    constexpr uint32_t CRC24_POLY = 0xFFF409;
+    constexpr double PI = 3.14159265358979323846;
+
+    constexpr std::array<uint32_t, 256> makeCrcTable() {
+        std::array<uint32_t, 256> table = {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i << 16;
+            for (int b = 0; b < 8; ++b) {
+                crc <<= 1;
+                if (crc & 0x1000000) crc ^= CRC24_POLY;
+            }
+            table[i] = crc & 0xFFFFFF;
+        }
+        return table;
+    }
+
+    constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+    /**
+     * Open-addressing hash from syndrome to error pattern
+     *
+     * Values pack up to two bit positions as (bit1 + 1) | (bit2 + 1) << 8;
+     * AMBIGUOUS marks syndromes shared by several patterns.
+     */
+    class SyndromeTable {
+    public:
+        static constexpr uint16_t AMBIGUOUS = 0xFFFF;
+
+        explicit SyndromeTable(int bits)
+            : m_keys(TABLE_SIZE, 0), m_values(TABLE_SIZE, 0)
+        {
+            // Single-bit syndromes; bits 0-4 (DF) are excluded
+            std::vector<uint32_t> single(bits, 0);
+            std::vector<uint8_t> msg(bits / 8);
+            for (int i = 5; i < bits; ++i) {
+                std::fill(msg.begin(), msg.end(), 0);
+                msg[i / 8] = static_cast<uint8_t>(0x80 >> (i % 8));
+                single[i] = ModeS::syndrome(msg.data(), bits);
+                insert(single[i], static_cast<uint16_t>(i + 1));
+            }
+
+            // Linearity: the syndrome of a double error is the xor of the singles
+            for (int i = 5; i < bits; ++i) {
+                for (int j = i + 1; j < bits; ++j) {
+                    insert(single[i] ^ single[j], static_cast<uint16_t>((i + 1) | ((j + 1) << 8)));
+                }
+            }
+        }
+
+        uint16_t find(uint32_t syndrome) const {
+            uint32_t slot = hash(syndrome);
+            while (m_keys[slot] != 0) {
+                if (m_keys[slot] == syndrome) return m_values[slot];
+                slot = (slot + 1) & (TABLE_SIZE - 1);
+            }
+            return 0;
+        }
+
+    private:
+        static constexpr uint32_t TABLE_SIZE = 16384; // > 2x the 6216 patterns of a 112-bit frame
+
+        static uint32_t hash(uint32_t syndrome) {
+            return (syndrome * 2654435761u) >> 18;
+        }
+
+        void insert(uint32_t syndrome, uint16_t value) {
+            uint32_t slot = hash(syndrome);
+            while (m_keys[slot] != 0) {
+                if (m_keys[slot] == syndrome) {
+                    m_values[slot] = AMBIGUOUS;
+                    return;
+                }
+                slot = (slot + 1) & (TABLE_SIZE - 1);
+            }
+            m_keys[slot] = syndrome;
+            m_values[slot] = value;
+        }
+
+        std::vector<uint32_t> m_keys;
+        std::vector<uint16_t> m_values;
+    };
+
+    const SyndromeTable& syndromeTable(int bits) {
+        static const SyndromeTable shortTable(56);
+        static const SyndromeTable longTable(112);
+        return bits == 56 ? shortTable : longTable;
+    }
+
+    const char* const AIS_CHARSET =
+        "#ABCDEFGHIJKLMNOPQRSTUVWXYZ##### ###############0123456789######";
+
+    void decodeIdentification(const uint8_t* me, ModeS::Message& out) {
+        uint64_t chars = 0;
+        for (int i = 1; i < 7; ++i) {
+            chars = (chars << 8) | me[i];
+        }
+
+        int len = 0;
+        for (int i = 0; i < 8; ++i) {
+            out.callsign[i] = AIS_CHARSET[(chars >> (42 - 6 * i)) & 0x3F];
+            if (out.callsign[i] != ' ') len = i + 1;
+        }
+        out.callsign[len] = '\0';
+        out.hasCallsign = len > 0;
+    }
+
+    void decodeAirbornePosition(const uint8_t* me, ModeS::Message& out) {
+        int ac12 = (me[1] << 4) | (me[2] >> 4);
+        if (ac12 != 0 && (ac12 & 0x010)) {
+            // 25 ft resolution; Gillham-coded (Q=0) altitudes are not decoded
+            int n = ((ac12 & 0xFE0) >> 1) | (ac12 & 0x00F);
+            out.altitudeFt = n * 25 - 1000;
+            out.hasAltitude = true;
+        }
+
+        out.cprOdd = (me[2] >> 2) & 1;
+        out.cprLat = ((me[2] & 0x03) << 15) | (me[3] << 7) | (me[4] >> 1);
+        out.cprLon = ((me[4] & 0x01) << 16) | (me[5] << 8) | me[6];
+        out.hasCpr = true;
+    }
+
+    // Surface movement field to knots (non-linear quantisation, DO-260B 2.2.3.2.4.2)
+    double decodeMovement(int movement) {
+        if (movement == 1) return 0.0;
+        if (movement <= 8) return 0.125 + (movement - 2) * 0.125;
+        if (movement <= 12) return 1.0 + (movement - 9) * 0.25;
+        if (movement <= 38) return 2.0 + (movement - 13) * 0.5;
+        if (movement <= 93) return 15.0 + (movement - 39);
+        if (movement <= 108) return 70.0 + (movement - 94) * 2.0;
+        if (movement <= 123) return 100.0 + (movement - 109) * 5.0;
+        return 175.0;
+    }
+
+    void decodeSurfacePosition(const uint8_t* me, ModeS::Message& out) {
+        int movement = ((me[0] & 0x07) << 4) | (me[1] >> 4);
+        if (movement > 0 && movement < 125 && (me[1] & 0x08)) {
+            out.groundSpeedKt = decodeMovement(movement);
+            out.trackDeg = (((me[1] & 0x07) << 4) | (me[2] >> 4)) * 360.0 / 128.0;
+            out.hasVelocity = true;
+        }
+
+        out.cprSurface = true;
+        out.cprOdd = (me[2] >> 2) & 1;
+        out.cprLat = ((me[2] & 0x03) << 15) | (me[3] << 7) | (me[4] >> 1);
+        out.cprLon = ((me[4] & 0x01) << 16) | (me[5] << 8) | me[6];
+        out.hasCpr = true;
+    }
+
+    inline int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    void decodeVelocity(const uint8_t* me, ModeS::Message& out) {
+        int subtype = me[0] & 0x07;
+
+        if (subtype == 1 || subtype == 2) {
+            int ewRaw = ((me[1] & 0x03) << 8) | me[2];
+            int nsRaw = ((me[3] & 0x7F) << 3) | (me[4] >> 5);
+            if (ewRaw != 0 && nsRaw != 0) {
+                int scale = (subtype == 2) ? 4 : 1; // Supersonic
+                double ew = (ewRaw - 1) * scale * ((me[1] & 0x04) ? -1.0 : 1.0);
+                double ns = (nsRaw - 1) * scale * ((me[3] & 0x80) ? -1.0 : 1.0);
+
+                out.groundSpeedKt = std::sqrt(ew * ew + ns * ns);
+                double track = std::atan2(ew, ns) * 180.0 / PI;
+                out.trackDeg = track < 0 ? track + 360.0 : track;
+                out.hasVelocity = true;
+            }
+        } else if (subtype == 3 || subtype == 4) {
+            // Airspeed + magnetic heading; best we have when no ground vector is sent
+            int airspeedRaw = ((me[3] & 0x7F) << 3) | (me[4] >> 5);
+            if ((me[1] & 0x04) && airspeedRaw != 0) {
+                int scale = (subtype == 4) ? 4 : 1;
+                out.trackDeg = (((me[1] & 0x03) << 8) | me[2]) * 360.0 / 1024.0;
+                out.groundSpeedKt = (airspeedRaw - 1) * scale;
+                out.hasVelocity = true;
+            }
+        } else {
+            return;
+        }
+
+        int vrRaw = ((me[4] & 0x07) << 6) | (me[5] >> 2);
+        if (vrRaw != 0) {
+            out.verticalRateFpm = (vrRaw - 1) * 64 * ((me[4] & 0x08) ? -1 : 1);
+            out.hasVerticalRate = true;
+        }
+    }
+}
+
+namespace ModeS {
+
+uint32_t crc24(const uint8_t* msg, int bits) {
+    uint32_t crc = 0;
+    int dataBytes = (bits - 24) / 8;
+
+    for (int i = 0; i < dataBytes; ++i) {
+        crc = ((crc << 8) ^ CRC_TABLE[((crc >> 16) ^ msg[i]) & 0xFF]) & 0xFFFFFF;
+    }
+
+    return crc;
+}
+
+uint32_t syndrome(const uint8_t* msg, int bits) {
+    const uint8_t* parity = msg + bits / 8 - 3;
+    uint32_t sent = (static_cast<uint32_t>(parity[0]) << 16) | (parity[1] << 8) | parity[2];
+    return crc24(msg, bits) ^ sent;
+}
+
+ErrorCorrector::ErrorCorrector(Mode mode)
+    : m_mode(mode)
+{
+    if (m_mode != NONE) {
+        syndromeTable(112); // Build the tables up front rather than on the first bad frame
+    }
+}
+
+int ErrorCorrector::correct(uint8_t* msg, int length) {
+    int df = msg[0] >> 3;
+    if (df != 11 && df != 17 && df != 18) return -1;
+    if (length != messageLength(df)) return -1;
+
+    const int bits = length * 8;
+    uint32_t syn = syndrome(msg, bits);
+    if (syn == 0) return 0;
+    if (m_mode == NONE) return -1;
+
+    uint16_t pattern = syndromeTable(bits).find(syn);
+    int bit1 = (pattern & 0xFF) - 1;
+    int bit2 = (pattern >> 8) - 1;
+
+    if (pattern == 0 || pattern == SyndromeTable::AMBIGUOUS ||
+        (bit2 >= 0 && m_mode != TWO_BIT)) {
+        ++m_stats.failed;
+        return -1;
+    }
+
+    msg[bit1 / 8] ^= static_cast<uint8_t>(0x80 >> (bit1 % 8));
+    if (bit2 >= 0) {
+        msg[bit2 / 8] ^= static_cast<uint8_t>(0x80 >> (bit2 % 8));
+        ++m_stats.corrected2;
+        return 2;
+    }
+
+    ++m_stats.corrected1;
+    return 1;
+}
+
+bool decode(const uint8_t* msg, int length, Message& out) {
+    out = Message();
+    out.df = msg[0] >> 3;
+
+    if (out.df != 17 && out.df != 18) return false;
+    if (length != LONG_MSG_BYTES) return false;
+    if (out.df == 18 && (msg[0] & 0x07) != 0) return false; // Only CF=0 carries an ICAO address
+
+    uint32_t parity = (static_cast<uint32_t>(msg[11]) << 16) | (msg[12] << 8) | msg[13];
+    if (crc24(msg, length * 8) != parity) return false;
+
+    out.icao = (static_cast<uint32_t>(msg[1]) << 16) | (msg[2] << 8) | msg[3];
+
+    const uint8_t* me = msg + 4;
+    out.typeCode = me[0] >> 3;
+
+    if (out.typeCode >= 1 && out.typeCode <= 4) {
+        decodeIdentification(me, out);
+    } else if (out.typeCode >= 5 && out.typeCode <= 8) {
+        decodeSurfacePosition(me, out);
+    } else if ((out.typeCode >= 9 && out.typeCode <= 18) ||
+               (out.typeCode >= 20 && out.typeCode <= 22)) {
+        decodeAirbornePosition(me, out);
+        // Type codes 20-22 carry GNSS height instead of barometric altitude
+        if (out.typeCode >= 20) out.hasAltitude = false;
+    } else if (out.typeCode == 19) {
+        decodeVelocity(me, out);
+    }
+
+    return true;
+}
+
+int parseAvr(const char* begin, const char* end, uint8_t* frame) {
+    while (end > begin && (end[-1] == '\r' || end[-1] == ' ')) --end;
+    if (end - begin < 2 || end[-1] != ';') return -1;
+    --end;
+
+    const char* p = begin + 1;
+    if (*begin == '@') {
+        p += 12; // 48-bit MLAT timestamp
+    } else if (*begin != '*') {
+        return -1;
+    }
+
+    long digits = end - p;
+    if (digits != SHORT_MSG_BYTES * 2 && digits != LONG_MSG_BYTES * 2) return -1;
+
+    int length = static_cast<int>(digits / 2);
+    for (int i = 0; i < length; ++i) {
+        int hi = hexValue(p[2 * i]);
+        int lo = hexValue(p[2 * i + 1]);
+        if (hi < 0 || lo < 0) return -1;
+        frame[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+
+    return length;
+}
+
+}
@@ -0,0 +1,158 @@
+#ifndef MODES_H
+#define MODES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Mode S / ADS-B extended squitter decoding
+ *
+ * Decodes DF17 (ADS-B) and DF18 (TIS-B/ADS-R, CF=0) messages into plain
+ * values. Frames can come from a Beast stream or from AVR text lines
+ * ("*8D...;" or "@<timestamp>8D...;"). Positions are left in raw CPR form;
+ * see cpr.h.
+ */
+namespace ModeS {
+    constexpr int SHORT_MSG_BYTES = 7;     // 56 bits
+    constexpr int LONG_MSG_BYTES = 14;     // 112 bits
+
+    struct Message {
+        int df = 0;                 // Downlink format
+        int typeCode = 0;           // ME type code (DF17/18)
+        uint32_t icao = 0;          // 24-bit address
+
+        bool hasCallsign = false;
+        char callsign[9] = {};      // NUL-terminated, trailing spaces stripped
+
+        bool hasAltitude = false;
+        int altitudeFt = 0;         // Barometric altitude (feet)
+
+        bool hasCpr = false;
+        bool cprSurface = false;    // Surface CPR uses 90 degree zones
+        bool cprOdd = false;
+        int cprLat = 0;             // 17-bit encoded latitude
+        int cprLon = 0;             // 17-bit encoded longitude
+
+        bool hasVelocity = false;
+        double groundSpeedKt = 0.0;
+        double trackDeg = 0.0;
+
+        bool hasVerticalRate = false;
+        int verticalRateFpm = 0;
+    };
+
+    // Message length in bytes for a given downlink format
+    inline int messageLength(int df) {
+        return df >= 16 ? LONG_MSG_BYTES : SHORT_MSG_BYTES;
+    }
+
+    /**
+     * CRC-24 (polynomial 0xFFF409) over the data part of a Mode S frame
+     *
+     * Table driven, one lookup per byte.
+     *
+     * @param msg Frame bytes
+     * @param bits Frame length in bits (56 or 112); the last 24 bits are parity
+     * @return Parity the transponder should have sent
+     */
+    uint32_t crc24(const uint8_t* msg, int bits);
+
+    /**
+     * CRC syndrome of a received frame: computed CRC xor transmitted parity.
+     * Zero for an intact DF11 (IID 0), DF17 or DF18 frame.
+     */
+    uint32_t syndrome(const uint8_t* msg, int bits);
+
+    /**
+     * Bit error correction for frames whose parity is not overlaid with an address
+     *
+     * The CRC is linear, so the syndrome of a damaged frame depends only on
+     * which bits flipped. Syndromes for every 1- and 2-bit error pattern of
+     * 56- and 112-bit frames are precomputed once into hash tables; correcting
+     * a frame is one CRC plus one lookup. The DF field itself is never touched.
+     */
+    class ErrorCorrector {
+    public:
+        enum Mode {
+            NONE,
+            SINGLE_BIT,     // Safe default
+            TWO_BIT         // Recovers more frames at a higher false-positive risk
+        };
+
+        struct Stats {
+            uint64_t corrected1 = 0;
+            uint64_t corrected2 = 0;
+            uint64_t failed = 0;
+        };
+
+        explicit ErrorCorrector(Mode mode = SINGLE_BIT);
+
+        void setMode(Mode mode) { m_mode = mode; }
+        Mode mode() const { return m_mode; }
+
+        /**
+         * Repair a DF11/17/18 frame in place
+         *
+         * @return Number of bits flipped (0 if the frame was already valid),
+         *         or -1 if it could not be repaired in the current mode
+         */
+        int correct(uint8_t* msg, int length);
+
+        const Stats& stats() const { return m_stats; }
+        void resetStats() { m_stats = Stats(); }
+
+    private:
+        Mode m_mode;
+        Stats m_stats;
+    };
+
+    /**
+     * Decode a DF17/DF18 extended squitter
+     *
+     * @param msg Frame bytes
+     * @param length Frame length in bytes (7 or 14)
+     * @return true if the frame passed the CRC and was decoded
+     */
+    bool decode(const uint8_t* msg, int length, Message& out);
+
+    /**
+     * Convert one AVR line to frame bytes
+     *
+     * @param begin/end Line without terminator, e.g. "*8D4840D6202CC371C32CE0576098;"
+     * @param frame Output buffer of at least LONG_MSG_BYTES
+     * @return Frame length in bytes, or -1 if the line is not a Mode S frame
+     */
+    int parseAvr(const char* begin, const char* end, uint8_t* frame);
+
+    /**
+     * Split an AVR text stream into lines and call sink(const uint8_t*, int)
+     * for every frame.
+     *
+     * @return Number of bytes consumed (up to and including the last newline)
+     */
+    template<typename Sink>
+    size_t parseAvrStream(const char* data, size_t size, Sink&& sink) {
+        size_t pos = 0;
+        uint8_t frame[LONG_MSG_BYTES];
+
+        while (pos < size) {
+            const void* nl = std::memchr(data + pos, '\n', size - pos);
+            if (!nl) {
+                return (size - pos > 64) ? size : pos; // No AVR line is this long
+            }
+
+            const char* lineEnd = static_cast<const char*>(nl);
+            int length = parseAvr(data + pos, lineEnd, frame);
+            if (length > 0) {
+                sink(static_cast<const uint8_t*>(frame), length);
+            }
+
+            pos = (lineEnd - data) + 1;
+        }
+
+        return pos;
+    }
+}
+
+#endif // MODES_H
@@ -0,0 +1,27 @@
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Process-wide monotonic time in nanoseconds
+ *
+ * Used for aircraft freshness and expiry. Unlike wall-clock time it never
+ * jumps when the system clock is adjusted, and reading it involves no
+ * timezone or calendar work. Values are only meaningful relative to each
+ * other within one process.
+ */
+namespace MonotonicClock {
+    constexpr int64_t NS_PER_MS = 1000000;
+    constexpr int64_t NS_PER_SEC = 1000000000;
+
+    inline int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    inline int64_t nowMs() { return nowNs() / NS_PER_MS; }
+}
+
+#endif // MONOTONICCLOCK_H
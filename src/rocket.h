@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include <QMetaType>
 
 class Rocket {
 public:
@@ -57,5 +58,7 @@ private:
     QString m_provider;  // SpaceX, NASA, etc.
 };
 
+Q_DECLARE_METATYPE(Rocket)
+
 #endif // ROCKET_H
 
@@ -1,28 +1,42 @@
 #include "rocketclient.h"
 #include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QRandomGenerator>
+#include <QFile>
+#include "monotonicclock.h"
 
 RocketClient::RocketClient(QObject* parent)
     : QObject(parent),
       m_networkManager(new QNetworkAccessManager(this)),
+      m_poller(new HttpPoller(m_networkManager, this)),
       m_updateTimer(new QTimer(this)),
       m_source(SIMULATED),
       m_userLat(0.0),
-      m_userLon(0.0)
+      m_userLon(0.0),
+      m_replay(new FeedReplay(this))
 {
     connect(m_updateTimer, &QTimer::timeout, this, &RocketClient::fetchData);
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &RocketClient::handleNetworkReply);
+    connect(m_poller, &HttpPoller::dataReceived, this, &RocketClient::handlePolledData);
+    connect(m_poller, &HttpPoller::failed, this, &RocketClient::handlePollFailed);
+    connect(m_replay, &FeedReplay::payload, this, [this](int kind, qint64, const QByteArray& data) {
+        if (kind == FeedRecording::HTTP_BODY) parseLaunchLibraryData(data);
+    });
+    connect(m_replay, &FeedReplay::finished, this, &RocketClient::replayFinished);
+    
+    // Launch Library 2 API - Free, no API key needed!
+    // Get upcoming launches (next 10)
+    QNetworkRequest request(QUrl("https://ll.thespacedevs.com/2.2.0/launch/upcoming/?limit=10&mode=detailed"));
+    request.setHeader(QNetworkRequest::UserAgentHeader, "AircraftRocketTracker/1.0");
+    m_poller->setRequest(request);
     
     setUpdateInterval(300000); // Update every 5 minutes
 }
 
 void RocketClient::setUpdateInterval(int msec) {
     m_updateTimer->setInterval(msec);
+    m_poller->setInterval(msec, msec * 6);  // Schedules rarely change; back off to 30 min
 }
 
 void RocketClient::setUserLocation(double lat, double lon) {
@@ -30,13 +44,50 @@ void RocketClient::setUserLocation(double lat, double lon) {
     m_userLon = lon;
 }
 
+void RocketClient::setReplayFile(const QString& path, double speed) {
+    m_replayPath = path;
+    m_replay->setSpeed(speed);
+}
+
 void RocketClient::start() {
+    if (m_source == REPLAY) {
+        startReplay();
+        return;
+    }
+    
+    if (m_source == LAUNCH_LIBRARY) {
+        if (!m_recordPath.isEmpty() &&
+            !m_recorder.open(QFile::encodeName(m_recordPath).toStdString(), RECORDING_TAG, m_source)) {
+            emit error(QString("Cannot write recording %1").arg(m_recordPath));
+        }
+        m_poller->start();  // Immediate first fetch
+        return;
+    }
+    
     m_updateTimer->start();
     fetchData(); // Immediate first fetch
 }
 
 void RocketClient::stop() {
+    m_poller->stop();
     m_updateTimer->stop();
+    m_replay->stop();
+    m_recorder.close();
+}
+
+bool RocketClient::startReplay() {
+    if (!m_replay->open(m_replayPath)) {
+        emit error(QString("Cannot read recording %1").arg(m_replayPath));
+        return false;
+    }
+    if (m_replay->tag() != RECORDING_TAG) {
+        m_replay->close();
+        emit error(QString("%1 is not a launch recording").arg(m_replayPath));
+        return false;
+    }
+    
+    m_replay->start();
+    return true;
 }
 
 void RocketClient::refresh() {
@@ -45,32 +96,31 @@ void RocketClient::refresh() {
 
 void RocketClient::fetchData() {
     if (m_source == LAUNCH_LIBRARY) {
-        // Launch Library 2 API - Free, no API key needed!
-        // Get upcoming launches (next 10)
-        QString url = "https://ll.thespacedevs.com/2.2.0/launch/upcoming/?limit=10&mode=detailed";
-        
-        QNetworkRequest request{QUrl(url)};
-        request.setHeader(QNetworkRequest::UserAgentHeader, "AircraftRocketTracker/1.0");
-        m_networkManager->get(request);
+        // Dropped while a request is in flight
+        m_poller->pollNow();
+    } else if (m_source == REPLAY) {
+        // The replay decides when the next response arrives
     } else {
         generateSimulatedData();
     }
 }
 
-void RocketClient::handleNetworkReply(QNetworkReply* reply) {
-    reply->deleteLater();
-    
-    if (reply->error() != QNetworkReply::NoError) {
-        emit error(QString("Network error: %1").arg(reply->errorString()));
-        // Fallback to simulated data on error
-        generateSimulatedData();
-        return;
+void RocketClient::handlePolledData(const QByteArray& data) {
+    if (m_recorder.isOpen() &&
+        !m_recorder.append(FeedRecording::HTTP_BODY, data.constData(), static_cast<size_t>(data.size()),
+                           MonotonicClock::nowNs())) {
+        m_recorder.close();
+        emit error(QString("Recording to %1 stopped: write failed").arg(m_recordPath));
     }
-    
-    QByteArray data = reply->readAll();
     parseLaunchLibraryData(data);
 }
 
+void RocketClient::handlePollFailed(const QString& message) {
+    emit error(QString("Network error: %1").arg(message));
+    // Fallback to simulated data on error
+    generateSimulatedData();
+}
+
 void RocketClient::parseLaunchLibraryData(const QByteArray& data) {
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (!doc.isObject()) {
@@ -130,6 +180,7 @@ void RocketClient::parseLaunchLibraryData(const QByteArray& data) {
         m_rockets.append(rocket);
     }
     
+    m_snapshots.publish(m_rockets);
     emit rocketsUpdated(m_rockets);
 }
 
@@ -176,6 +227,7 @@ void RocketClient::generateSimulatedData() {
         m_rockets.append(rocket);
     }
     
+    m_snapshots.publish(m_rockets);
     emit rocketsUpdated(m_rockets);
 }
 
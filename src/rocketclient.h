@@ -5,7 +5,15 @@
 #include <QNetworkAccessManager>
 #include <QTimer>
 #include <QVector>
+#include <memory>
 #include "rocket.h"
+#include "snapshotstore.h"
+#include "httppoller.h"
+#include "feedrecording.h"
+#include "feedreplay.h"
+
+// Immutable published launch list
+using RocketSnapshot = std::shared_ptr<const QVector<Rocket>>;
 
 /**
  * Rocket Launch Client - Fetches upcoming rocket launches
@@ -19,9 +27,12 @@ class RocketClient : public QObject {
 public:
     enum Source {
         LAUNCH_LIBRARY,     // Launch Library 2 API (thespacedevs.com)
-        SIMULATED           // Simulated data for testing
+        SIMULATED,          // Simulated data for testing
+        REPLAY              // FeedRecording of Launch Library responses
     };
     
+    static constexpr const char* RECORDING_TAG = "rckt";
+    
     explicit RocketClient(QObject* parent = nullptr);
     ~RocketClient() override = default;
     
@@ -29,29 +40,49 @@ public:
     void setUpdateInterval(int msec);
     void setUserLocation(double lat, double lon);
     
+    // Launch Library responses received after the next start(); empty stops recording
+    void setRecordFile(const QString& path) { m_recordPath = path; }
+    
+    // Recording played by the REPLAY source; speed as in FeedReplay::setSpeed()
+    void setReplayFile(const QString& path, double speed = 1.0);
+    
     void start();
     void stop();
     void refresh();
     
-    QVector<Rocket> getRockets() const { return m_rockets; }
+    // Parse one Launch Library response body, as if it had just arrived
+    void processDocument(const QByteArray& data) { parseLaunchLibraryData(data); }
+    
+    // Last published launch list; safe to call from any thread
+    RocketSnapshot getRockets() const { return m_snapshots.current(); }
     
 signals:
     void rocketsUpdated(const QVector<Rocket>& rockets);
     void error(const QString& message);
+    void replayFinished();
     
 private slots:
     void fetchData();
-    void handleNetworkReply(QNetworkReply* reply);
+    void handlePolledData(const QByteArray& data);
+    void handlePollFailed(const QString& message);
     
 private:
     QNetworkAccessManager* m_networkManager;
-    QTimer* m_updateTimer;
+    HttpPoller* m_poller;           // Launch Library
+    QTimer* m_updateTimer;          // Simulation ticks
     Source m_source;
     QVector<Rocket> m_rockets;
+    SnapshotStore<QVector<Rocket>> m_snapshots;
     
     double m_userLat;
     double m_userLon;
     
+    FeedRecording::Writer m_recorder;
+    QString m_recordPath;
+    FeedReplay* m_replay;
+    QString m_replayPath;
+    
+    bool startReplay();
     void parseLaunchLibraryData(const QByteArray& data);
     void generateSimulatedData();
 };
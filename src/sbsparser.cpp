@@ -0,0 +1,143 @@
+#include "sbsparser.h"
+
+namespace {
+    constexpr int FIELD_COUNT = 22;
+
+    struct Field {
+        const char* begin;
+        const char* end;
+
+        bool empty() const { return begin == end; }
+    };
+
+    constexpr double POW10[] = {
+        1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+    };
+
+    bool parseInt(const Field& f, int& value) {
+        const char* p = f.begin;
+        bool negative = false;
+        if (p < f.end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (p == f.end) return false;
+
+        int v = 0;
+        for (; p < f.end; ++p) {
+            unsigned d = static_cast<unsigned>(*p - '0');
+            if (d > 9) return false;
+            v = v * 10 + static_cast<int>(d);
+        }
+        value = negative ? -v : v;
+        return true;
+    }
+
+    // Plain decimal notation only; SBS never uses exponents
+    bool parseDouble(const Field& f, double& value) {
+        const char* p = f.begin;
+        bool negative = false;
+        if (p < f.end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        bool inFraction = false;
+
+        for (; p < f.end; ++p) {
+            if (*p == '.' && !inFraction) {
+                inFraction = true;
+                continue;
+            }
+            unsigned d = static_cast<unsigned>(*p - '0');
+            if (d > 9) return false;
+            if (digits < 18) {
+                mantissa = mantissa * 10 + d;
+                ++digits;
+                if (inFraction) ++fractionDigits;
+            }
+        }
+        if (digits == 0) return false;
+
+        double v = static_cast<double>(mantissa) / POW10[fractionDigits];
+        value = negative ? -v : v;
+        return true;
+    }
+
+    bool parseHex24(const Field& f, uint32_t& value) {
+        if (f.end - f.begin != 6) return false;
+
+        uint32_t v = 0;
+        for (const char* p = f.begin; p < f.end; ++p) {
+            char c = *p;
+            uint32_t d;
+            if (c >= '0' && c <= '9') d = c - '0';
+            else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+            else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+            else return false;
+            v = (v << 4) | d;
+        }
+        value = v;
+        return true;
+    }
+}
+
+namespace Sbs {
+
+bool parseLine(const char* begin, const char* end, Message& out) {
+    if (end - begin < 4 || begin[0] != 'M' || begin[1] != 'S' || begin[2] != 'G' || begin[3] != ',') {
+        return false;
+    }
+
+    Field fields[FIELD_COUNT];
+    int count = 0;
+    const char* start = begin;
+    for (const char* p = begin; p <= end && count < FIELD_COUNT; ++p) {
+        if (p == end || *p == ',') {
+            fields[count++] = {start, p};
+            start = p + 1;
+        }
+    }
+    if (count < 11) return false;
+    for (int i = count; i < FIELD_COUNT; ++i) {
+        fields[i] = {end, end};
+    }
+
+    out = Message();
+    if (!parseInt(fields[1], out.type) || out.type < 1 || out.type > 8) return false;
+    if (!parseHex24(fields[4], out.icao)) return false;
+
+    // Callsign (MSG,1)
+    const Field& cs = fields[10];
+    if (!cs.empty()) {
+        int len = 0;
+        for (const char* p = cs.begin; p < cs.end && len < 8; ++p) {
+            out.callsign[len++] = *p;
+        }
+        while (len > 0 && out.callsign[len - 1] == ' ') --len;
+        out.callsign[len] = '\0';
+        out.hasCallsign = len > 0;
+    }
+
+    out.hasAltitude = parseInt(fields[11], out.altitudeFt);
+
+    // Speed and track come together (MSG,2 and MSG,4)
+    out.hasVelocity = parseDouble(fields[12], out.groundSpeedKt) &&
+                      parseDouble(fields[13], out.trackDeg);
+
+    out.hasPosition = parseDouble(fields[14], out.lat) &&
+                      parseDouble(fields[15], out.lon) &&
+                      out.lat >= -90.0 && out.lat <= 90.0 &&
+                      out.lon >= -180.0 && out.lon <= 180.0;
+
+    out.hasVerticalRate = parseInt(fields[16], out.verticalRateFpm);
+    out.hasSquawk = parseInt(fields[17], out.squawk);
+
+    return true;
+}
+
+}
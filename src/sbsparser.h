@@ -0,0 +1,87 @@
+#ifndef SBSPARSER_H
+#define SBSPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * SBS-1 / BaseStation CSV parser (dump1090 / readsb port 30003)
+ *
+ * Line layout (22 comma separated fields):
+ *   MSG,<type>,<session>,<aircraft>,<hex>,<flight>,<date>,<time>,<date>,<time>,
+ *   <callsign>,<altitude>,<speed>,<track>,<lat>,<lon>,<vrate>,<squawk>,
+ *   <alert>,<emergency>,<spi>,<ground>
+ *
+ * Fields are tokenized as (pointer, length) views into the socket buffer and
+ * converted without building any intermediate strings.
+ */
+namespace Sbs {
+    constexpr size_t MAX_LINE_LENGTH = 512;
+
+    struct Message {
+        int type = 0;               // Transmission type 1..8
+        uint32_t icao = 0;
+
+        bool hasCallsign = false;
+        char callsign[9] = {};
+
+        bool hasAltitude = false;
+        int altitudeFt = 0;
+
+        bool hasVelocity = false;
+        double groundSpeedKt = 0.0;
+        double trackDeg = 0.0;
+
+        bool hasPosition = false;
+        double lat = 0.0;
+        double lon = 0.0;
+
+        bool hasVerticalRate = false;
+        int verticalRateFpm = 0;
+
+        bool hasSquawk = false;
+        int squawk = 0;             // Four octal digits as written, e.g. 7700
+    };
+
+    /**
+     * Parse one line (without the line terminator)
+     *
+     * @return true for a well-formed MSG line with a valid hex ident
+     */
+    bool parseLine(const char* begin, const char* end, Message& out);
+
+    /**
+     * Parse every complete line in [data, data + size) and call
+     * sink(const Message&) for each valid MSG line.
+     *
+     * @return Number of bytes consumed (up to and including the last newline)
+     */
+    template<typename Sink>
+    size_t parse(const char* data, size_t size, Sink&& sink) {
+        size_t pos = 0;
+        Message msg;
+
+        while (pos < size) {
+            const void* nl = std::memchr(data + pos, '\n', size - pos);
+            if (!nl) {
+                // Drop runaway garbage rather than buffering it forever
+                return (size - pos > MAX_LINE_LENGTH) ? size : pos;
+            }
+
+            const char* lineEnd = static_cast<const char*>(nl);
+            const char* end = lineEnd;
+            if (end > data + pos && end[-1] == '\r') --end;
+
+            if (parseLine(data + pos, end, msg)) {
+                sink(msg);
+            }
+
+            pos = (lineEnd - data) + 1;
+        }
+
+        return pos;
+    }
+}
+
+#endif // SBSPARSER_H
@@ -0,0 +1,131 @@
+#ifndef SNAPSHOTSTORE_H
+#define SNAPSHOTSTORE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * Versioned store of immutable snapshots
+ *
+ * The writer builds a new value and publishes it in one step; readers get a
+ * shared pointer to whichever version was current and can hold on to it for
+ * as long as they like without copying or locking. Older versions are freed
+ * when the last reader lets go. The lock only guards the pointer swap, so
+ * current() is safe from any thread.
+ *
+ * A writer that keeps its own working copy can publish it with the
+ * catch-up overload, which double buffers: the version before the current
+ * one is reused once no reader holds it, so each publish costs what
+ * changed rather than a copy of the whole value. Versions are handed back
+ * explicitly: the deleter of the last reference parks the buffer under a
+ * mutex, which orders that reader's accesses before the writer's reuse.
+ * Polling use_count() would not; it is a relaxed load.
+ */
+template<typename T>
+class SnapshotStore {
+public:
+    using Snapshot = std::shared_ptr<const T>;
+
+    SnapshotStore()
+        : m_recycler(std::make_shared<Recycler>()),
+          m_version(0)
+    {
+        m_current = share(std::unique_ptr<T>(new T()), 0);
+    }
+
+    // Publish a new version and return its number (first publish is 1)
+    uint64_t publish(T value) {
+        return publishBuffer(std::unique_ptr<T>(new T(std::move(value))));
+    }
+
+    /**
+     * Publish a copy of working, and return its version
+     *
+     * catchUp(T& older) is handed the version published before the current
+     * one when no reader holds it any more, and must make it equal to
+     * working; a writer that tracks what changed over its last two publishes
+     * pays only for those changes. While a reader still holds that version,
+     * working is copied instead, into an older released buffer if any.
+     */
+    template<typename CatchUp>
+    uint64_t publish(const T& working, CatchUp catchUp) {
+        std::unique_ptr<T> next;
+        uint64_t nextVersion = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_recycler->mutex);
+            next.swap(m_recycler->spare);
+            nextVersion = m_recycler->spareVersion;
+        }
+
+        // Only the writer changes m_version, so it can be read without the lock
+        if (next && nextVersion + 1 == m_version) {
+            catchUp(*next);
+        } else if (next) {
+            *next = working;    // Too old to catch up, but its storage is reused
+        } else {
+            next.reset(new T(working));
+        }
+        return publishBuffer(std::move(next));
+    }
+
+    Snapshot current() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_current;
+    }
+
+    // Snapshot together with its version number, read consistently
+    Snapshot current(uint64_t& version) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        version = m_version;
+        return m_current;
+    }
+
+    uint64_t version() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_version;
+    }
+
+private:
+    // Newest released version, waiting for the catch-up publish()
+    struct Recycler {
+        std::mutex mutex;
+        std::unique_ptr<T> spare;
+        uint64_t spareVersion = 0;
+    };
+
+    // Deleter of a snapshot: parks the buffer instead of freeing it
+    struct Release {
+        std::shared_ptr<Recycler> recycler;     // Outlives the store if a reader does
+        uint64_t version;
+
+        void operator()(const T* value) const {
+            std::unique_ptr<T> buffer(const_cast<T*>(value));   // Freed outside the lock if not kept
+            std::lock_guard<std::mutex> lock(recycler->mutex);
+            if (!recycler->spare || recycler->spareVersion < version) {
+                recycler->spare.swap(buffer);
+                recycler->spareVersion = version;
+            }
+        }
+    };
+
+    mutable std::mutex m_mutex;
+    std::shared_ptr<Recycler> m_recycler;
+    Snapshot m_current;
+    uint64_t m_version;
+
+    Snapshot share(std::unique_ptr<T> buffer, uint64_t version) {
+        return Snapshot(buffer.release(), Release{m_recycler, version});
+    }
+
+    uint64_t publishBuffer(std::unique_ptr<T> next) {
+        Snapshot snapshot = share(std::move(next), m_version + 1);
+        Snapshot retired;   // Released outside the lock
+        std::lock_guard<std::mutex> lock(m_mutex);
+        retired.swap(m_current);
+        m_current.swap(snapshot);
+        return ++m_version;
+    }
+};
+
+#endif // SNAPSHOTSTORE_H
@@ -0,0 +1,156 @@
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialIndex::SpatialIndex(double cellDegrees)
+    : m_cellDegrees(cellDegrees),
+      m_rows(static_cast<int>(std::ceil(180.0 / cellDegrees))),
+      m_cols(static_cast<int>(std::ceil(360.0 / cellDegrees)))
+{
+}
+
+void SpatialIndex::clear() {
+    m_cells.clear();
+    m_locations.clear();
+}
+
+int SpatialIndex::row(double lat) const {
+    int r = static_cast<int>(std::floor((lat + 90.0) / m_cellDegrees));
+    return std::min(std::max(r, 0), m_rows - 1);
+}
+
+int SpatialIndex::col(double lon) const {
+    // 180 itself stays in the last column, so a box ending there covers it
+    if (lon > 180.0) lon -= 360.0;
+    else if (lon < -180.0) lon += 360.0;
+    int c = static_cast<int>(std::floor((lon + 180.0) / m_cellDegrees));
+    return std::min(std::max(c, 0), m_cols - 1);
+}
+
+void SpatialIndex::update(uint32_t id, double lat, double lon) {
+    uint32_t cell = cellKey(row(lat), col(lon));
+
+    auto it = m_locations.find(id);
+    if (it != m_locations.end()) {
+        Location& location = it->second;
+        if (location.cell == cell) {
+            Entry& entry = m_cells[cell][location.slot];
+            entry.lat = lat;
+            entry.lon = lon;
+            return;
+        }
+        removeFromCell(location.cell, location.slot);
+    }
+
+    std::vector<Entry>& entries = m_cells[cell];
+    m_locations[id] = Location{cell, static_cast<uint32_t>(entries.size())};
+    entries.push_back(Entry{id, lat, lon});
+}
+
+bool SpatialIndex::remove(uint32_t id) {
+    auto it = m_locations.find(id);
+    if (it == m_locations.end()) return false;
+
+    removeFromCell(it->second.cell, it->second.slot);
+    m_locations.erase(it);
+    return true;
+}
+
+void SpatialIndex::removeFromCell(uint32_t cell, uint32_t slot) {
+    auto it = m_cells.find(cell);
+    std::vector<Entry>& entries = it->second;
+
+    // Fill the hole with the last entry and repoint its location
+    if (slot + 1 != entries.size()) {
+        entries[slot] = entries.back();
+        m_locations[entries[slot].id].slot = slot;
+    }
+    entries.pop_back();
+
+    // Empty cells are dropped, so m_cells.size() counts occupied cells
+    if (entries.empty()) m_cells.erase(it);
+}
+
+template<typename Fn>
+void SpatialIndex::forEachInBox(const GeoUtils::BoundingBox& box, Fn fn) const {
+    const int row0 = row(box.minLat);
+    const int row1 = row(box.maxLat);
+    const int col0 = col(box.minLon);
+    const int col1 = col(box.maxLon);
+    const bool wraps = box.wrapsAntimeridian();
+
+    // Column span, in two pieces across the antimeridian; both ends can share a cell
+    const int colCount = std::min(wraps ? (m_cols - col0) + (col1 + 1) : col1 - col0 + 1, m_cols);
+    const long long boxCells = static_cast<long long>(row1 - row0 + 1) * colCount;
+
+    auto visit = [&](const std::vector<Entry>& entries) {
+        for (const Entry& entry : entries) {
+            if (box.contains(entry.lat, entry.lon)) fn(entry);
+        }
+    };
+
+    if (boxCells > static_cast<long long>(m_cells.size())) {
+        // Large box over a sparse grid: the occupied cells are fewer
+        for (const auto& cell : m_cells) {
+            int r = static_cast<int>(cell.first / m_cols);
+            int c = static_cast<int>(cell.first % m_cols);
+            if (r < row0 || r > row1) continue;
+            if (wraps ? (c < col0 && c > col1) : (c < col0 || c > col1)) continue;
+            visit(cell.second);
+        }
+        return;
+    }
+
+    for (int r = row0; r <= row1; ++r) {
+        for (int i = 0; i < colCount; ++i) {
+            int c = (col0 + i) % m_cols;
+            auto it = m_cells.find(cellKey(r, c));
+            if (it != m_cells.end()) visit(it->second);
+        }
+    }
+}
+
+void SpatialIndex::queryBox(const GeoUtils::BoundingBox& box, std::vector<uint32_t>& out) const {
+    forEachInBox(box, [&](const Entry& entry) {
+        out.push_back(entry.id);
+    });
+}
+
+void SpatialIndex::queryRadius(double lat, double lon, double radius, std::vector<uint32_t>& out) const {
+    GeoUtils::RadiusFilter filter(lat, lon, radius);
+    forEachInBox(filter.box(), [&](const Entry& entry) {
+        if (filter.contains(entry.lat, entry.lon)) out.push_back(entry.id);
+    });
+}
+
+std::vector<SpatialIndex::Neighbor> SpatialIndex::nearest(double lat, double lon, int k,
+                                                          double maxDistance) const {
+    std::vector<Neighbor> found;
+    if (k <= 0 || isEmpty()) return found;
+
+    // Half the circumference reaches every point
+    const double limit = std::min(maxDistance, GeoUtils::PI * GeoUtils::EARTH_RADIUS);
+    double radius = std::min(GeoUtils::EARTH_RADIUS * GeoUtils::toRadians(m_cellDegrees), limit);
+
+    // Once k points lie within the radius, no point outside it can be closer
+    for (;;) {
+        found.clear();
+        forEachInBox(GeoUtils::boundingBox(lat, lon, radius), [&](const Entry& entry) {
+            double distance = GeoUtils::calculateDistance(lat, lon, entry.lat, entry.lon);
+            if (distance <= radius) found.push_back(Neighbor{entry.id, distance});
+        });
+        if (static_cast<int>(found.size()) >= k || radius >= limit) break;
+        radius = std::min(radius * 2.0, limit);
+    }
+
+    auto closer = [](const Neighbor& a, const Neighbor& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+    };
+    if (static_cast<int>(found.size()) > k) {
+        std::partial_sort(found.begin(), found.begin() + k, found.end(), closer);
+        found.resize(k);
+    } else {
+        std::sort(found.begin(), found.end(), closer);
+    }
+    return found;
+}
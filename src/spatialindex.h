@@ -0,0 +1,93 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "geoutils.h"
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Uniform latitude/longitude grid over points keyed by a 32-bit id
+ *
+ * Each point lives in the cell containing it; only occupied cells are
+ * stored, so the grid costs nothing over empty sky and the globe. Moving a
+ * point within its cell rewrites it in place, and moving it to another
+ * cell is a swap-remove from one cell's array and an append to the other,
+ * so the index follows the fleet with one update per position change.
+ *
+ * A query visits the cells its bounding box overlaps, or every occupied
+ * cell when there are fewer of those, and tests only the points in them:
+ * the work grows with the area asked about and the points found there,
+ * not with the number of points indexed. Boxes may wrap across the
+ * antimeridian.
+ *
+ * Ids are the aircraft addresses in MapWidget; any unique id works.
+ */
+class SpatialIndex {
+public:
+    struct Neighbor {
+        uint32_t id;
+        double distance;    // meters
+    };
+
+    // Default cell edge: a quarter degree, about 28 km north-south
+    static constexpr double DEFAULT_CELL_DEGREES = 0.25;
+
+    explicit SpatialIndex(double cellDegrees = DEFAULT_CELL_DEGREES);
+
+    int size() const { return static_cast<int>(m_locations.size()); }
+    bool isEmpty() const { return m_locations.empty(); }
+    bool contains(uint32_t id) const { return m_locations.count(id) != 0; }
+    void clear();
+
+    // Insert id at (lat, lon), or move it there
+    void update(uint32_t id, double lat, double lon);
+    bool remove(uint32_t id);
+
+    // Ids inside the box, appended to out in no particular order
+    void queryBox(const GeoUtils::BoundingBox& box, std::vector<uint32_t>& out) const;
+
+    // Ids within radius meters of (lat, lon), by haversine distance
+    void queryRadius(double lat, double lon, double radius, std::vector<uint32_t>& out) const;
+
+    /**
+     * The k ids closest to (lat, lon), nearest first, none further than
+     * maxDistance
+     *
+     * Searches a radius of one cell and doubles it until k points are inside
+     * or the radius covers maxDistance, so sparse areas cost a few more
+     * rounds rather than a scan of the whole index.
+     */
+    std::vector<Neighbor> nearest(double lat, double lon, int k,
+                                  double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+private:
+    struct Entry {
+        uint32_t id;
+        double lat;
+        double lon;
+    };
+
+    struct Location {
+        uint32_t cell;
+        uint32_t slot;      // Index into the cell's entries
+    };
+
+    double m_cellDegrees;
+    int m_rows;
+    int m_cols;
+    std::unordered_map<uint32_t, std::vector<Entry>> m_cells;  // Occupied cells only
+    std::unordered_map<uint32_t, Location> m_locations;
+
+    int row(double lat) const;
+    int col(double lon) const;
+    uint32_t cellKey(int row, int col) const { return static_cast<uint32_t>(row) * m_cols + col; }
+    void removeFromCell(uint32_t cell, uint32_t slot);
+
+    // fn(const Entry&) for every point inside box
+    template<typename Fn>
+    void forEachInBox(const GeoUtils::BoundingBox& box, Fn fn) const;
+};
+
+#endif // SPATIALINDEX_H
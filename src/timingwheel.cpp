@@ -0,0 +1,116 @@
+#include "timingwheel.h"
+#include "monotonicclock.h"
+#include <algorithm>
+
+TimingWheel::TimingWheel(int64_t tickNs, int slotCount)
+    : m_tickNs(tickNs),
+      m_heads(slotCount, NIL),
+      m_freeList(NIL),
+      m_nextTick(MonotonicClock::nowNs() / tickNs)
+{
+}
+
+int TimingWheel::slotFor(int64_t deadlineNs) const {
+    // Deadlines already behind the wheel go into the next slot to be processed
+    int64_t tick = std::max(deadlineNs / m_tickNs, m_nextTick);
+    return static_cast<int>(tick % static_cast<int64_t>(m_heads.size()));
+}
+
+void TimingWheel::link(int node, int slot) {
+    Node& n = m_nodes[node];
+    n.slot = slot;
+    n.prev = NIL;
+    n.next = m_heads[slot];
+    if (n.next != NIL) m_nodes[n.next].prev = node;
+    m_heads[slot] = node;
+}
+
+void TimingWheel::unlink(int node) {
+    Node& n = m_nodes[node];
+    if (n.prev != NIL) m_nodes[n.prev].next = n.next;
+    else m_heads[n.slot] = n.next;
+    if (n.next != NIL) m_nodes[n.next].prev = n.prev;
+}
+
+void TimingWheel::schedule(uint32_t key, int64_t deadlineNs) {
+    int slot = slotFor(deadlineNs);
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        Node& n = m_nodes[it->second];
+        n.deadlineNs = deadlineNs;
+        // Most refreshes land in the same slot as before
+        if (n.slot != slot) {
+            unlink(it->second);
+            link(it->second, slot);
+        }
+        return;
+    }
+
+    int node;
+    if (m_freeList != NIL) {
+        node = m_freeList;
+        m_freeList = m_nodes[node].next;
+    } else {
+        node = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+    }
+    m_nodes[node].key = key;
+    m_nodes[node].deadlineNs = deadlineNs;
+    link(node, slot);
+    m_index.emplace(key, node);
+}
+
+void TimingWheel::cancel(uint32_t key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) return;
+
+    unlink(it->second);
+    m_nodes[it->second].next = m_freeList;
+    m_freeList = it->second;
+    m_index.erase(it);
+}
+
+void TimingWheel::clear() {
+    std::fill(m_heads.begin(), m_heads.end(), NIL);
+    m_nodes.clear();
+    m_freeList = NIL;
+    m_index.clear();
+}
+
+void TimingWheel::restart(int64_t nowNs) {
+    clear();
+    m_nextTick = nowNs / m_tickNs;
+}
+
+void TimingWheel::collectExpired(int64_t nowNs) {
+    m_expired.clear();
+
+    // Only ticks that have fully elapsed are processed
+    int64_t endTick = nowNs / m_tickNs;
+    if (endTick <= m_nextTick) return;
+
+    // One revolution visits every slot; skipping further is free
+    int64_t slotCount = static_cast<int64_t>(m_heads.size());
+    int64_t steps = m_index.empty() ? 0 : std::min(endTick - m_nextTick, slotCount);
+
+    for (int64_t s = 0; s < steps; ++s) {
+        int slot = static_cast<int>((m_nextTick + s) % slotCount);
+        int node = m_heads[slot];
+        while (node != NIL) {
+            Node& n = m_nodes[node];
+            int next = n.next;
+            // Entries due in a later revolution stay put
+            if (n.deadlineNs <= nowNs) {
+                unlink(node);
+                m_expired.push_back(n.key);
+                m_index.erase(n.key);
+                n.next = m_freeList;
+                m_freeList = node;
+            }
+            node = next;
+        }
+    }
+
+    m_nextTick = endTick;
+}
@@ -0,0 +1,78 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Hashed timing wheel of per-key deadlines
+ *
+ * Deadlines are hashed by tick into a ring of slots, each holding an
+ * intrusive doubly linked list, so schedule() and cancel() are O(1) and
+ * advance() only visits the slots whose ticks have elapsed. With the wheel
+ * spanning more than the longest deadline, every entry in a visited slot is
+ * due, and expiry costs O(expired) rather than O(keys). Deadlines further
+ * out simply stay in their slot for another revolution.
+ *
+ * A key fires on the first advance() after its deadline's tick has ended,
+ * so at most one tick late. Times are MonotonicClock nanoseconds.
+ */
+class TimingWheel {
+public:
+    TimingWheel(int64_t tickNs, int slotCount);
+
+    // Set or move the deadline of key
+    void schedule(uint32_t key, int64_t deadlineNs);
+    void cancel(uint32_t key);
+    void clear();
+
+    // Drop every key and continue from nowNs, which may be behind the times seen so far
+    void restart(int64_t nowNs);
+
+    int size() const { return static_cast<int>(m_index.size()); }
+    bool isEmpty() const { return m_index.empty(); }
+
+    /**
+     * Remove every key whose deadline has passed and call expire(key) for it
+     *
+     * The callback runs after the wheel is updated, so it may schedule or
+     * cancel keys itself.
+     *
+     * @return number of keys expired
+     */
+    template<typename Expire>
+    int advance(int64_t nowNs, Expire&& expire) {
+        collectExpired(nowNs);
+        for (uint32_t key : m_expired) {
+            expire(key);
+        }
+        return static_cast<int>(m_expired.size());
+    }
+
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        uint32_t key;
+        int64_t deadlineNs;
+        int slot;
+        int prev;
+        int next;       // Also links the free list
+    };
+
+    int64_t m_tickNs;
+    std::vector<int> m_heads;       // First node of each slot, NIL if empty
+    std::vector<Node> m_nodes;
+    int m_freeList;
+    int64_t m_nextTick;             // First tick not yet fully elapsed and processed
+    std::unordered_map<uint32_t, int> m_index;  // Key -> node
+    std::vector<uint32_t> m_expired;
+
+    int slotFor(int64_t deadlineNs) const;
+    void link(int node, int slot);
+    void unlink(int node);
+    void collectExpired(int64_t nowNs);
+};
+
+#endif // TIMINGWHEEL_H
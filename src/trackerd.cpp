@@ -0,0 +1,12 @@
+#include <QCoreApplication>
+#include "trackerdaemon.h"
+
+// Headless tracker: links tracker_core only, no QtWidgets or QtGui
+int main(int argc, char* argv[]) {
+    QCoreApplication::setApplicationName("trackerd");
+    QCoreApplication::setApplicationVersion("1.0");
+    QCoreApplication::setOrganizationName("AeroTracker");
+    QCoreApplication::setOrganizationDomain("aerotracker.local");
+
+    return TrackerDaemon::exec(argc, argv);
+}
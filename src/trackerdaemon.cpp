@@ -0,0 +1,361 @@
+#include "trackerdaemon.h"
+#include "geoutils.h"
+#include "monotonicclock.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <cstdio>
+#include <string>
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace {
+    struct FeedKind {
+        const char* name;
+        ADSBClient::Source source;
+    };
+
+    const FeedKind FEED_KINDS[] = {
+        {"opensky",  ADSBClient::OPENSKY_NETWORK},
+        {"dump1090", ADSBClient::DUMP1090_LOCAL},
+        {"beast",    ADSBClient::BEAST_TCP},
+        {"sbs",      ADSBClient::SBS_TCP},
+        {"avr",      ADSBClient::AVR_TCP},
+        {"sim",      ADSBClient::SIMULATED},
+    };
+
+#ifdef Q_OS_UNIX
+    // Self-pipe: the handler only writes a byte, the event loop does the rest
+    int g_signalPipe[2] = {-1, -1};
+
+    void onTerminationSignal(int) {
+        char byte = 1;
+        ssize_t written = ::write(g_signalPipe[1], &byte, 1);
+        (void)written;
+    }
+
+    void quitOnTerminationSignals(QCoreApplication& app) {
+        if (::pipe(g_signalPipe) != 0) return;
+
+        QSocketNotifier* notifier = new QSocketNotifier(g_signalPipe[0], QSocketNotifier::Read, &app);
+        QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier]() {
+            char byte;
+            ssize_t got = ::read(g_signalPipe[0], &byte, 1);
+            (void)got;
+            notifier->setEnabled(false);
+            QCoreApplication::quit();
+        });
+
+        struct sigaction action = {};
+        action.sa_handler = onTerminationSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+    }
+#endif
+
+    // Printable ASCII without the characters JSON strings would need escaped
+    void appendCallsign(std::string& out, const QByteArray& callsign) {
+        for (char c : callsign) {
+            out += (c >= ' ' && c <= '~' && c != '"' && c != '\\') ? c : '?';
+        }
+    }
+}
+
+TrackerDaemon::TrackerDaemon(const Options& options, QObject* parent)
+    : QObject(parent),
+      m_options(options),
+      m_aircraft(new AircraftFusion(this)),
+      m_launches(nullptr),
+      m_snapshotTimer(new QTimer(this)),
+      m_statusTimer(new QTimer(this)),
+      m_writtenVersion(0)
+{
+    m_snapshotTimer->setSingleShot(true);
+    m_snapshotTimer->setInterval(m_options.snapshotIntervalMs);
+    connect(m_snapshotTimer, &QTimer::timeout, this, &TrackerDaemon::writeSnapshot);
+    connect(m_statusTimer, &QTimer::timeout, this, &TrackerDaemon::logStatus);
+
+    connect(m_aircraft, &AircraftFusion::aircraftChanged, this, &TrackerDaemon::onAircraftChanged);
+    connect(m_aircraft, &AircraftFusion::error, this, [](const QString& message) {
+        qWarning("aircraft: %s", qPrintable(message));
+    });
+
+    if (m_options.launches || m_options.simulateLaunches || !m_options.replayLaunches.isEmpty()) {
+        m_launches = new RocketClient(this);
+        connect(m_launches, &RocketClient::error, this, [](const QString& message) {
+            qWarning("launches: %s", qPrintable(message));
+        });
+    }
+}
+
+bool TrackerDaemon::addFeed(const QString& spec, QString* errorMessage) {
+    // <kind>[@host[:port]]
+    QString kind = spec.section('@', 0, 0).trimmed().toLower();
+    QString endpoint = spec.section('@', 1);
+
+    const FeedKind* feedKind = nullptr;
+    for (const FeedKind& k : FEED_KINDS) {
+        if (kind == QLatin1String(k.name)) feedKind = &k;
+    }
+    if (!feedKind) {
+        if (errorMessage) *errorMessage = QString("unknown feed kind '%1'").arg(kind);
+        return false;
+    }
+
+    // The same kind twice (two receivers, say) gets numbered names
+    QString name = kind;
+    for (int n = 2; m_aircraft->feed(name); ++n) {
+        name = QString("%1-%2").arg(kind).arg(n);
+    }
+    if (!m_aircraft->addFeed(name, feedKind->source)) {
+        if (errorMessage) *errorMessage = QString("cannot add feed '%1'").arg(spec);
+        return false;
+    }
+
+    if (!endpoint.isEmpty()) {
+        bool portOk = true;
+        QString host = endpoint.section(':', 0, 0);
+        QString port = endpoint.section(':', 1);
+        quint16 portNumber = port.isEmpty() ? 0 : port.toUShort(&portOk);
+        if (!portOk || host.isEmpty()) {
+            m_aircraft->removeFeed(name);
+            if (errorMessage) *errorMessage = QString("invalid endpoint in '%1'").arg(spec);
+            return false;
+        }
+        m_aircraft->feed(name)->setStreamEndpoint(host, portNumber);
+    }
+    return true;
+}
+
+bool TrackerDaemon::start(QString* errorMessage) {
+    m_aircraft->setUserLocation(m_options.latitude, m_options.longitude);
+    m_aircraft->setSearchRadius(m_options.searchRadius);
+    m_aircraft->setRecordDirectory(m_options.recordDir);
+    m_aircraft->setSimulation(m_options.simulation, m_options.simulateStream);
+
+    if (!m_options.replayAircraft.isEmpty()) {
+        if (!m_aircraft->addReplayFeed("replay", m_options.replayAircraft, m_options.replaySpeed)) {
+            if (errorMessage) *errorMessage = QString("cannot replay %1").arg(m_options.replayAircraft);
+            return false;
+        }
+    }
+    QStringList feeds = m_options.feeds;
+    if (feeds.isEmpty() && m_options.replayAircraft.isEmpty()) {
+        feeds.append("sim");
+    }
+    for (const QString& spec : feeds) {
+        if (!addFeed(spec, errorMessage)) return false;
+    }
+    m_aircraft->start();
+
+    if (m_launches) {
+        m_launches->setUserLocation(m_options.latitude, m_options.longitude);
+        if (!m_options.replayLaunches.isEmpty()) {
+            m_launches->setSource(RocketClient::REPLAY);
+            m_launches->setReplayFile(m_options.replayLaunches, m_options.replaySpeed);
+        } else {
+            m_launches->setSource(m_options.simulateLaunches ? RocketClient::SIMULATED
+                                                             : RocketClient::LAUNCH_LIBRARY);
+            if (!m_options.recordDir.isEmpty()) {
+                QString stamp = QDateTime::currentDateTimeUtc().toString("yyyyMMdd-HHmmss");
+                m_launches->setRecordFile(QDir(m_options.recordDir).filePath(QString("launches-%1.rec").arg(stamp)));
+            }
+        }
+        m_launches->start();
+    }
+
+    if (m_options.statusIntervalS > 0) {
+        m_statusTimer->start(m_options.statusIntervalS * 1000);
+    }
+    return true;
+}
+
+void TrackerDaemon::stop() {
+    m_snapshotTimer->stop();
+    m_statusTimer->stop();
+    m_aircraft->stop();
+    if (m_launches) m_launches->stop();
+
+    // The file reflects the last merge even if the throttle was still holding it
+    if (!m_options.snapshotFile.isEmpty() && m_aircraft->aircraftVersion() != m_writtenVersion) {
+        writeSnapshot();
+    }
+}
+
+void TrackerDaemon::onAircraftChanged() {
+    if (m_options.snapshotFile.isEmpty() || m_snapshotTimer->isActive()) return;
+
+    // Leading edge: a quiet feed's change is written at once, a busy one's once per interval
+    writeSnapshot();
+    m_snapshotTimer->start();
+}
+
+void TrackerDaemon::writeSnapshot() {
+    uint64_t version = m_aircraft->aircraftVersion();
+    if (version == m_writtenVersion) return;
+    AircraftSnapshot snapshot = m_aircraft->getAircraft();
+
+    QByteArray json = aircraftJson(*snapshot, MonotonicClock::nowNs(), QDateTime::currentMSecsSinceEpoch());
+
+    // Written beside the target and renamed over it
+    QSaveFile file(m_options.snapshotFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() || !file.commit()) {
+        qWarning("cannot write %s: %s", qPrintable(m_options.snapshotFile), qPrintable(file.errorString()));
+        return;
+    }
+    m_writtenVersion = version;
+}
+
+void TrackerDaemon::logStatus() {
+    QString line = QString("aircraft %1").arg(m_aircraft->getAircraft()->size());
+    if (m_launches) {
+        line += QString(", launches %1").arg(m_launches->getRockets()->size());
+    }
+    for (const AircraftFusion::FeedStats& stats : *m_aircraft->getFeedStats()) {
+        line += QString(", %1 %2").arg(stats.name).arg(stats.aircraft);
+    }
+    qInfo("%s", qPrintable(line));
+}
+
+QByteArray TrackerDaemon::aircraftJson(const AircraftTable& aircraft, int64_t nowNs, qint64 wallNowMs) {
+    std::string out;
+    out.reserve(64 + static_cast<size_t>(aircraft.size()) * 200);
+
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "{ \"now\" : %.1f,\n  \"aircraft\" : [", wallNowMs / 1000.0);
+    out += buffer;
+
+    bool first = true;
+    for (const Aircraft& ac : aircraft) {
+        uint32_t address = ac.getAddress();
+        std::snprintf(buffer, sizeof(buffer), "%s\n    {\"hex\":\"%s%06x\"",
+                      first ? "" : ",", (address & Aircraft::NON_ICAO_FLAG) ? "~" : "",
+                      address & 0xFFFFFF);
+        out += buffer;
+        first = false;
+
+        QByteArray callsign = ac.getCallsign().toLatin1();
+        if (!callsign.isEmpty()) {
+            out += ",\"flight\":\"";
+            appendCallsign(out, callsign);
+            out += '"';
+        }
+        if (ac.hasPosition()) {
+            std::snprintf(buffer, sizeof(buffer),
+                          ",\"lat\":%.6f,\"lon\":%.6f,\"alt_baro\":%d,\"gs\":%.1f,\"track\":%.1f,\"baro_rate\":%d",
+                          ac.getLatitude(), ac.getLongitude(),
+                          static_cast<int>(GeoUtils::metersToFeet(ac.getAltitude())),
+                          GeoUtils::metersPerSecondToKnots(ac.getVelocity()), ac.getHeading(),
+                          static_cast<int>(GeoUtils::metersToFeet(ac.getVerticalRate()) * 60.0));
+            out += buffer;
+        }
+        if (ac.getSquawk() >= 0) {
+            std::snprintf(buffer, sizeof(buffer), ",\"squawk\":\"%04d\"", ac.getSquawk());
+            out += buffer;
+        }
+        double seen = static_cast<double>(nowNs - ac.getLastSeen()) / MonotonicClock::NS_PER_SEC;
+        std::snprintf(buffer, sizeof(buffer), ",\"seen\":%.1f}", seen > 0.0 ? seen : 0.0);
+        out += buffer;
+    }
+    out += "\n  ]\n}\n";
+    return QByteArray(out.data(), static_cast<int>(out.size()));
+}
+
+int TrackerDaemon::exec(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Aircraft and rocket launch tracker, headless ingestion");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption headlessOption("headless",
+        "Run without a user interface (implied by this executable).");
+    QCommandLineOption feedOption("feed",
+        "ADS-B feed <kind>[@host[:port]], kind one of opensky, dump1090, beast, sbs, avr, sim. "
+        "Repeat for several feeds; default sim.", "spec");
+    QCommandLineOption latOption("lat", "Latitude of the receiver in degrees.", "degrees", "34.0522");
+    QCommandLineOption lonOption("lon", "Longitude of the receiver in degrees.", "degrees", "-118.2437");
+    QCommandLineOption radiusOption("radius", "Search radius in km.", "km", "100");
+    QCommandLineOption launchesOption("launches",
+        "Launch source: launchlibrary, sim or none.", "source", "launchlibrary");
+    QCommandLineOption snapshotOption("snapshot",
+        "Keep <file> updated with the merged aircraft in dump1090 aircraft.json format.", "file");
+    QCommandLineOption snapshotIntervalOption("snapshot-interval",
+        "Minimum time between snapshot writes in ms.", "ms", "1000");
+    QCommandLineOption statusOption("status-interval",
+        "Seconds between status lines, 0 for none.", "seconds", "60");
+    QCommandLineOption recordOption("record",
+        "Record every network feed into <dir>.", "dir");
+    QCommandLineOption replayAircraftOption("replay-aircraft",
+        "Play an ADS-B recording.", "file");
+    QCommandLineOption replayLaunchesOption("replay-launches",
+        "Play a launch recording.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay speed: 1 = recorded pace, 0 = as fast as possible.", "factor", "1");
+    QCommandLineOption simAircraftOption("sim-aircraft",
+        "Number of simulated aircraft.", "count", "8");
+    QCommandLineOption simSeedOption("sim-seed",
+        "Seed of the simulated traffic.", "seed", "1");
+    QCommandLineOption simChurnOption("sim-churn",
+        "Share of the simulated fleet that lands and is replaced per hour.", "rate", "0.5");
+    QCommandLineOption simStreamOption("sim-stream",
+        "Feed simulated traffic through the SBS-1 parser as raw messages.");
+    parser.addOptions({headlessOption, feedOption, latOption, lonOption, radiusOption,
+                       launchesOption, snapshotOption, snapshotIntervalOption, statusOption,
+                       recordOption, replayAircraftOption, replayLaunchesOption, replaySpeedOption,
+                       simAircraftOption, simSeedOption, simChurnOption, simStreamOption});
+    parser.process(app);
+
+    Options options;
+    options.latitude = parser.value(latOption).toDouble();
+    options.longitude = parser.value(lonOption).toDouble();
+    options.searchRadius = parser.value(radiusOption).toDouble() * 1000.0;
+    options.feeds = parser.values(feedOption);
+    QString launches = parser.value(launchesOption).toLower();
+    if (launches != "launchlibrary" && launches != "sim" && launches != "none") {
+        std::fprintf(stderr, "unknown launch source '%s'\n", qPrintable(launches));
+        return 2;
+    }
+    options.launches = launches == "launchlibrary";
+    options.simulateLaunches = launches == "sim";
+    options.snapshotFile = parser.value(snapshotOption);
+    options.snapshotIntervalMs = parser.value(snapshotIntervalOption).toInt();
+    options.statusIntervalS = parser.value(statusOption).toInt();
+    options.recordDir = parser.value(recordOption);
+    options.replayAircraft = parser.value(replayAircraftOption);
+    options.replayLaunches = parser.value(replayLaunchesOption);
+    options.replaySpeed = parser.value(replaySpeedOption).toDouble();
+    options.simulation.aircraft = parser.value(simAircraftOption).toInt();
+    options.simulation.seed = parser.value(simSeedOption).toULongLong();
+    options.simulation.churnPerHour = parser.value(simChurnOption).toDouble();
+    options.simulateStream = parser.isSet(simStreamOption);
+
+    // Deltas are emitted by the fusion as in the GUI, only without a thread hop
+    qRegisterMetaType<AircraftSnapshot>("AircraftSnapshot");
+    qRegisterMetaType<AircraftDelta>("AircraftDelta");
+    qRegisterMetaType<QVector<Rocket>>("QVector<Rocket>");
+
+    TrackerDaemon daemon(options);
+    QString errorMessage;
+    if (!daemon.start(&errorMessage)) {
+        std::fprintf(stderr, "%s\n", qPrintable(errorMessage));
+        return 2;
+    }
+
+#ifdef Q_OS_UNIX
+    // Recordings get their index and the snapshot its last state on a clean exit
+    quitOnTerminationSignals(app);
+#endif
+
+    int result = app.exec();
+    daemon.stop();
+    return result;
+}
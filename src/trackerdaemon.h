@@ -0,0 +1,93 @@
+#ifndef TRACKERDAEMON_H
+#define TRACKERDAEMON_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include "aircraftfusion.h"
+#include "rocketclient.h"
+#include "trafficsimulator.h"
+
+/**
+ * Ingestion without a user interface
+ *
+ * Runs the same feeds, fusion and launch client as the GUI, but on the
+ * calling thread and with nothing on screen: no widgets, no painting, no
+ * sweep timer. The merged table can be re-served as a dump1090-style
+ * aircraft.json file, which is written atomically so any web server or
+ * another tracker polling it never reads half a document. Counts per feed
+ * go to the log at a fixed interval.
+ *
+ * Only QtCore and QtNetwork are used, so the daemon links against the
+ * tracker_core library alone and several instances fit on one host.
+ */
+class TrackerDaemon : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        double latitude = 34.0522;      // Los Angeles, as in the GUI
+        double longitude = -118.2437;
+        double searchRadius = 100000.0; // meters
+
+        // Feed specs "<kind>[@host[:port]]", kind one of opensky, dump1090,
+        // beast, sbs, avr, sim; empty runs the simulation
+        QStringList feeds;
+        bool launches = true;           // Poll Launch Library 2
+        bool simulateLaunches = false;  // Simulated launches instead
+
+        QString recordDir;
+        QString replayAircraft;
+        QString replayLaunches;
+        double replaySpeed = 1.0;
+
+        TrafficSimulator::Config simulation;
+        bool simulateStream = false;
+
+        QString snapshotFile;           // aircraft.json to re-serve; empty = none
+        int snapshotIntervalMs = 1000;  // At most one write per interval
+        int statusIntervalS = 60;       // 0 = no periodic status line
+    };
+
+    explicit TrackerDaemon(const Options& options, QObject* parent = nullptr);
+    ~TrackerDaemon() override = default;
+
+    // Add the feeds and start polling; false with a message if a feed spec is invalid
+    bool start(QString* errorMessage = nullptr);
+    void stop();
+
+    AircraftFusion* aircraft() const { return m_aircraft; }
+    RocketClient* launches() const { return m_launches; }
+
+    /**
+     * Render a snapshot in dump1090's aircraft.json format
+     *
+     * Only fields this tracker parses back are written: hex, flight, lat,
+     * lon, alt_baro, gs, track, baro_rate, squawk and seen.
+     */
+    static QByteArray aircraftJson(const AircraftTable& aircraft, int64_t nowNs, qint64 wallNowMs);
+
+    /**
+     * Entry point of the headless process: parses the command line, runs
+     * until SIGINT/SIGTERM and returns the exit code
+     */
+    static int exec(int argc, char* argv[]);
+
+private slots:
+    void onAircraftChanged();
+    void writeSnapshot();
+    void logStatus();
+
+private:
+    Options m_options;
+    AircraftFusion* m_aircraft;
+    RocketClient* m_launches;
+    QTimer* m_snapshotTimer;        // Throttles snapshot writes
+    QTimer* m_statusTimer;
+    uint64_t m_writtenVersion;      // Fusion version last written to the snapshot file
+
+    bool addFeed(const QString& spec, QString* errorMessage);
+};
+
+#endif // TRACKERDAEMON_H
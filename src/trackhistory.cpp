@@ -0,0 +1,132 @@
+#include "trackhistory.h"
+
+namespace {
+    constexpr uint32_t MIN_SLOTS = 16;
+}
+
+TrackHistory::TrackHistory(int maxTracks)
+    : m_freeList(nullptr),
+      m_maxTracks(maxTracks),
+      m_count(0),
+      m_mask(0),
+      m_shift(32)
+{
+    rehash(MIN_SLOTS);
+}
+
+TrackHistory::Track* TrackHistory::allocate() {
+    if (!m_freeList) {
+        if (m_count >= m_maxTracks) return nullptr;
+
+        // Thread a new slab onto the free list
+        std::unique_ptr<Track[]> slab(new Track[SLAB_RINGS]);
+        for (int i = 0; i < SLAB_RINGS; ++i) {
+            slab[i].m_nextFree = (i + 1 < SLAB_RINGS) ? &slab[i + 1] : nullptr;
+        }
+        m_freeList = &slab[0];
+        m_slabs.push_back(std::move(slab));
+    }
+
+    Track* track = m_freeList;
+    m_freeList = track->m_nextFree;
+    track->m_head = 0;
+    track->m_count = 0;
+    track->m_nextFree = nullptr;
+    return track;
+}
+
+uint32_t TrackHistory::findSlot(uint32_t icao) const {
+    uint32_t i = home(icao);
+    while (m_slots[i].key != icao && m_slots[i].key != EMPTY) {
+        i = (i + 1) & m_mask;
+    }
+    return i;
+}
+
+bool TrackHistory::append(uint32_t icao, const Point& point) {
+    uint32_t i = findSlot(icao);
+    Track* track = m_slots[i].track;
+
+    if (m_slots[i].key == EMPTY) {
+        if (m_count >= m_maxTracks) return false;
+        track = allocate();
+        if (!track) return false;
+
+        if (static_cast<size_t>(m_count + 1) * 2 > m_slots.size()) {
+            rehash(static_cast<uint32_t>(m_slots.size()) * 2);
+            i = findSlot(icao);
+        }
+        m_slots[i].key = icao;
+        m_slots[i].track = track;
+        ++m_count;
+    } else if (track->m_count > 0 &&
+               track->newest().lat == point.lat && track->newest().lon == point.lon) {
+        return true;
+    }
+
+    track->m_points[track->m_head] = point;
+    track->m_head = (track->m_head + 1) % CAPACITY;
+    if (track->m_count < CAPACITY) ++track->m_count;
+    return true;
+}
+
+void TrackHistory::remove(uint32_t icao) {
+    uint32_t hole = findSlot(icao);
+    if (m_slots[hole].key == EMPTY) return;
+
+    Track* track = m_slots[hole].track;
+    track->m_nextFree = m_freeList;
+    m_freeList = track;
+    --m_count;
+
+    // Backward-shift deletion, as in AircraftTable::remove
+    uint32_t i = hole;
+    for (;;) {
+        i = (i + 1) & m_mask;
+        if (m_slots[i].key == EMPTY) break;
+
+        uint32_t h = home(m_slots[i].key);
+        bool movable = (hole <= i) ? (h <= hole || h > i) : (h <= hole && h > i);
+        if (movable) {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole].key = EMPTY;
+}
+
+void TrackHistory::clear() {
+    for (Slot& slot : m_slots) {
+        if (slot.key != EMPTY) {
+            slot.track->m_nextFree = m_freeList;
+            m_freeList = slot.track;
+            slot.key = EMPTY;
+        }
+    }
+    m_count = 0;
+}
+
+const TrackHistory::Track* TrackHistory::find(uint32_t icao) const {
+    const Slot& slot = m_slots[findSlot(icao)];
+    return slot.key == EMPTY ? nullptr : slot.track;
+}
+
+size_t TrackHistory::memoryUsage() const {
+    return m_slabs.size() * SLAB_RINGS * sizeof(Track) + m_slots.size() * sizeof(Slot);
+}
+
+void TrackHistory::rehash(uint32_t slotCount) {
+    std::vector<Slot> old;
+    old.swap(m_slots);
+
+    m_slots.assign(slotCount, Slot{EMPTY, nullptr});
+    m_mask = slotCount - 1;
+    m_shift = 32;
+    for (uint32_t n = slotCount; n > 1; n >>= 1) --m_shift;
+
+    for (const Slot& slot : old) {
+        if (slot.key != EMPTY) {
+            m_slots[findSlot(slot.key)] = slot;
+        }
+    }
+}
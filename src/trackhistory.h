@@ -0,0 +1,93 @@
+#ifndef TRACKHISTORY_H
+#define TRACKHISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Recent positions of every tracked aircraft, keyed by 24-bit address
+ *
+ * Each aircraft gets a fixed-capacity ring of points. Rings are carved out
+ * of slabs of SLAB_RINGS rings and recycled through a free list, so aircraft
+ * coming and going never reaches malloc once the high-water mark is reached,
+ * and memory is bounded by maxTracks * sizeof(ring). The address index is a
+ * small open-addressing table like AircraftTable's.
+ */
+class TrackHistory {
+public:
+    static constexpr int CAPACITY = 32;     // Points kept per aircraft
+    static constexpr int SLAB_RINGS = 64;   // Rings allocated at a time
+
+    struct Point {
+        int64_t timeMs;     // MonotonicClock time (ms)
+        double lat;         // degrees
+        double lon;         // degrees
+        float altitude;     // meters
+        float speed;        // m/s
+        float heading;      // degrees
+    };
+
+    /**
+     * Read-only view of one aircraft's ring, oldest point first
+     */
+    class Track {
+    public:
+        int size() const { return m_count; }
+        bool isEmpty() const { return m_count == 0; }
+        const Point& at(int i) const { return m_points[(m_head + CAPACITY - m_count + i) % CAPACITY]; }
+        const Point& newest() const { return at(m_count - 1); }
+
+    private:
+        friend class TrackHistory;
+        Point m_points[CAPACITY];
+        int m_head = 0;         // Next write position
+        int m_count = 0;
+        Track* m_nextFree = nullptr;
+    };
+
+    explicit TrackHistory(int maxTracks = 16384);
+
+    /**
+     * Append a point to an aircraft's ring, starting a new ring if needed
+     *
+     * A point at the same position as the newest one is dropped.
+     *
+     * @return false if a new ring would exceed maxTracks
+     */
+    bool append(uint32_t icao, const Point& point);
+
+    void remove(uint32_t icao);
+    void clear();
+
+    const Track* find(uint32_t icao) const;
+    int size() const { return m_count; }
+
+    // Bytes held by slabs and index, i.e. the high-water mark
+    size_t memoryUsage() const;
+
+private:
+    static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+    struct Slot {
+        uint32_t key;
+        Track* track;
+    };
+
+    std::vector<std::unique_ptr<Track[]>> m_slabs;
+    Track* m_freeList;
+    int m_maxTracks;
+    int m_count;
+
+    std::vector<Slot> m_slots;  // Power-of-two size, at most half full
+    uint32_t m_mask;
+    int m_shift;
+
+    uint32_t home(uint32_t icao) const { return (icao * 2654435769u) >> m_shift; }
+    uint32_t findSlot(uint32_t icao) const;
+    void rehash(uint32_t slotCount);
+    Track* allocate();
+};
+
+#endif // TRACKHISTORY_H
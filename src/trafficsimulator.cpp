@@ -0,0 +1,348 @@
+#include "trafficsimulator.h"
+#include "geoutils.h"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    constexpr double TURN_RATE = 3.0;           // deg/s, standard rate turn
+    constexpr double CLIMB_RATE = 10.0;         // m/s
+    constexpr double DESCENT_RATE = 8.0;        // m/s
+    constexpr double ACCELERATION = 1.0;        // m/s²
+    constexpr double LOWEST_LEVEL = 3000.0;     // m
+    constexpr double LEVEL_SPACING = 300.0;     // m, about 1000 ft
+    constexpr int LEVEL_COUNT = 31;             // Up to 12 km
+    constexpr double EXIT_MARGIN = 1.05;        // Of the radius, before an aircraft has left
+    constexpr double DEPARTURE_RADIUS = 0.8;    // Of the radius, where departures take off
+    constexpr uint32_t CALLSIGN_PERIOD = 16;    // Steps between SBS identification messages
+
+    const char* const AIRLINES[] = {
+        "AAL", "DAL", "UAL", "SWA", "BAW", "DLH", "AFR", "KLM",
+        "RYR", "EZY", "ACA", "QFA", "UAE", "SIA", "JAL", "ANA"
+    };
+
+    // True airspeed of a typical airliner at an altitude: ~80 m/s near the ground, ~270 at 12 km
+    double cruiseSpeed(double altitude) {
+        return 80.0 + 0.016 * std::max(altitude, 0.0);
+    }
+
+    double normalizeDegrees(double degrees) {
+        degrees = std::fmod(degrees, 360.0);
+        return degrees < 0.0 ? degrees + 360.0 : degrees;
+    }
+
+    double clampMagnitude(double value, double limit) {
+        return std::max(-limit, std::min(limit, value));
+    }
+
+    // Text output helpers; each returns the end of what it wrote
+    char* put(char* p, const char* text) {
+        while (*text) *p++ = *text++;
+        return p;
+    }
+
+    char* putInt(char* p, long value) {
+        unsigned long v = value < 0 ? 0ul - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+        if (value < 0) *p++ = '-';
+        char digits[24];
+        int n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v);
+        while (n) *p++ = digits[--n];
+        return p;
+    }
+
+    char* putFixed(char* p, double value, int decimals) {
+        long scale = 1;
+        for (int i = 0; i < decimals; ++i) scale *= 10;
+        long scaled = std::lround(value * scale);
+        if (scaled < 0) {
+            *p++ = '-';
+            scaled = -scaled;
+        }
+        p = putInt(p, scaled / scale);
+        *p++ = '.';
+        long fraction = scaled % scale;
+        for (long digit = scale / 10; digit > 0; digit /= 10) {
+            *p++ = static_cast<char>('0' + fraction / digit % 10);
+        }
+        return p;
+    }
+
+    char* putHex6(char* p, uint32_t value) {
+        static const char HEX[] = "0123456789ABCDEF";
+        for (int shift = 20; shift >= 0; shift -= 4) {
+            *p++ = HEX[(value >> shift) & 0xF];
+        }
+        return p;
+    }
+
+    // Point reached from (lat, lon) after distance meters on an initial bearing
+    void destination(double lat, double lon, double bearing, double distance,
+                     double& outLat, double& outLon) {
+        double phi1 = GeoUtils::toRadians(lat);
+        double theta = GeoUtils::toRadians(bearing);
+        double delta = distance / GeoUtils::EARTH_RADIUS;
+
+        double sinPhi2 = std::sin(phi1) * std::cos(delta) +
+                         std::cos(phi1) * std::sin(delta) * std::cos(theta);
+        double phi2 = std::asin(std::max(-1.0, std::min(1.0, sinPhi2)));
+        double dLon = std::atan2(std::sin(theta) * std::sin(delta) * std::cos(phi1),
+                                 std::cos(delta) - std::sin(phi1) * sinPhi2);
+
+        outLat = GeoUtils::toDegrees(phi2);
+        outLon = normalizeDegrees(lon + GeoUtils::toDegrees(dLon) + 180.0) - 180.0;
+    }
+}
+
+TrafficSimulator::TrafficSimulator()
+    : TrafficSimulator(Config())
+{
+}
+
+TrafficSimulator::TrafficSimulator(const Config& config)
+    : m_config(config),
+      m_rng(config.seed),
+      m_nextAddress(0),
+      m_timeS(0.0),
+      m_centerLat(0.0),
+      m_centerLon(0.0),
+      m_radius(100000.0)
+{
+}
+
+uint64_t TrafficSimulator::next() {
+    // SplitMix64: tiny state, full period, identical output everywhere
+    uint64_t z = (m_rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double TrafficSimulator::uniform() {
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double TrafficSimulator::uniform(double lo, double hi) {
+    return lo + (hi - lo) * uniform();
+}
+
+double TrafficSimulator::flightLevel() {
+    return LOWEST_LEVEL + LEVEL_SPACING * static_cast<int>(uniform() * LEVEL_COUNT);
+}
+
+void TrafficSimulator::reset(double lat, double lon, double radius) {
+    for (const Target& t : m_targets) {
+        m_departed.push_back(t.icao);
+    }
+    m_targets.clear();
+
+    m_rng = m_config.seed;
+    m_nextAddress = 0;
+    m_timeS = 0.0;
+    m_centerLat = lat;
+    m_centerLon = lon;
+    m_radius = radius;
+    spawnFleet();
+}
+
+void TrafficSimulator::setArea(double lat, double lon, double radius) {
+    for (const Target& t : m_targets) {
+        m_departed.push_back(t.icao);
+    }
+    m_targets.clear();
+
+    m_centerLat = lat;
+    m_centerLon = lon;
+    m_radius = radius;
+    spawnFleet();
+}
+
+void TrafficSimulator::spawnFleet() {
+    int population = std::min(m_config.aircraft, MAX_AIRCRAFT);
+    m_targets.reserve(population);
+    for (int i = 0; i < population; ++i) {
+        spawnInside(m_radius, flightLevel());
+    }
+}
+
+void TrafficSimulator::spawnInside(double maxDistance, double altitude) {
+    // Uniform over the disc, not clustered at the centre
+    double distance = maxDistance * std::sqrt(uniform());
+    double bearing = uniform(0.0, 360.0);
+    double lat, lon;
+    destination(m_centerLat, m_centerLon, bearing, distance, lat, lon);
+
+    addTarget(lat, lon, uniform(0.0, 360.0), altitude, altitude > 0.0 ? altitude : flightLevel());
+}
+
+void TrafficSimulator::spawnAtEdge() {
+    double bearing = uniform(0.0, 360.0);
+    double lat, lon;
+    destination(m_centerLat, m_centerLon, bearing, m_radius, lat, lon);
+
+    // Heading roughly back across the area
+    double heading = normalizeDegrees(bearing + 180.0 + uniform(-60.0, 60.0));
+    double altitude = flightLevel();
+    addTarget(lat, lon, heading, altitude, altitude);
+}
+
+void TrafficSimulator::addTarget(double lat, double lon, double heading,
+                                 double altitude, double targetAltitude) {
+    Target t;
+    t.icao = ADDRESS_BASE + m_nextAddress;
+    m_nextAddress = (m_nextAddress + 1) % ADDRESS_COUNT;
+
+    uint64_t id = next();
+    std::snprintf(t.callsign, sizeof(t.callsign), "%s%d",
+                  AIRLINES[id % (sizeof(AIRLINES) / sizeof(AIRLINES[0]))],
+                  static_cast<int>(1 + (id >> 8) % 9999));
+
+    t.lat = lat;
+    t.lon = lon;
+    t.altitude = altitude;
+    t.speed = cruiseSpeed(altitude);
+    t.heading = heading;
+    t.verticalRate = 0.0;
+    t.phase = targetAltitude > altitude ? CLIMB : CRUISE;
+    t.targetAltitude = targetAltitude;
+    t.turnRemaining = 0.0;
+    t.nextManeuverS = uniform(30.0, 600.0);
+    t.steps = 0;
+
+    m_targets.push_back(t);
+}
+
+void TrafficSimulator::step(double dtSeconds) {
+    m_timeS += dtSeconds;
+
+    int landed = 0;
+    int left = 0;
+    for (size_t i = 0; i < m_targets.size();) {
+        Target& t = m_targets[i];
+        if (move(t, dtSeconds)) {
+            ++i;
+            continue;
+        }
+
+        m_departed.push_back(t.icao);
+        ++(t.phase == LANDING ? landed : left);
+        t = m_targets.back();
+        m_targets.pop_back();
+    }
+
+    // Every landing is matched by a departure and every exit by an arrival
+    for (int i = 0; i < landed; ++i) {
+        spawnInside(m_radius * DEPARTURE_RADIUS, 0.0);
+    }
+    for (int i = 0; i < left; ++i) {
+        spawnAtEdge();
+    }
+
+    // The configured population may have changed
+    int population = std::min(m_config.aircraft, MAX_AIRCRAFT);
+    while (static_cast<int>(m_targets.size()) < population) {
+        spawnAtEdge();
+    }
+    while (static_cast<int>(m_targets.size()) > population) {
+        m_departed.push_back(m_targets.back().icao);
+        m_targets.pop_back();
+    }
+}
+
+void TrafficSimulator::maneuver(Target& t) {
+    double choice = uniform();
+    if (choice < 0.5) {
+        double turn = uniform(15.0, 90.0);
+        t.turnRemaining += uniform() < 0.5 ? -turn : turn;
+    } else if (choice < 0.8) {
+        t.targetAltitude = flightLevel();
+    }
+    t.nextManeuverS = uniform(60.0, 600.0);
+}
+
+bool TrafficSimulator::move(Target& t, double dt) {
+    ++t.steps;
+
+    if (t.phase != LANDING) {
+        t.nextManeuverS -= dt;
+        if (t.nextManeuverS <= 0.0) maneuver(t);
+
+        if (uniform() < m_config.churnPerHour * dt / 3600.0) {
+            t.phase = LANDING;
+            t.targetAltitude = 0.0;
+        }
+    }
+
+    // Vertical: constant rate towards the cleared level
+    double dz = t.targetAltitude - t.altitude;
+    double rate = dz > 0.0 ? CLIMB_RATE : DESCENT_RATE;
+    double climb = clampMagnitude(dz, rate * dt);
+    t.altitude += climb;
+    t.verticalRate = dt > 0.0 ? climb / dt : 0.0;
+
+    if (t.phase == LANDING) {
+        if (t.altitude <= 0.0) return false;
+    } else {
+        t.phase = climb > 0.0 ? CLIMB : (climb < 0.0 ? DESCENT : CRUISE);
+    }
+
+    // Speed follows altitude
+    t.speed += clampMagnitude(cruiseSpeed(t.altitude) - t.speed, ACCELERATION * dt);
+
+    // Standard-rate turn, then along the great circle
+    if (t.turnRemaining != 0.0) {
+        double turn = clampMagnitude(t.turnRemaining, TURN_RATE * dt);
+        t.heading = normalizeDegrees(t.heading + turn);
+        t.turnRemaining -= turn;
+    }
+
+    double lat, lon;
+    destination(t.lat, t.lon, t.heading, t.speed * dt, lat, lon);
+
+    // The track at the new point is the reverse of the bearing back
+    t.heading = normalizeDegrees(GeoUtils::calculateBearing(lat, lon, t.lat, t.lon) + 180.0);
+    t.lat = lat;
+    t.lon = lon;
+
+    return GeoUtils::calculateDistance(m_centerLat, m_centerLon, lat, lon) <= m_radius * EXIT_MARGIN;
+}
+
+void TrafficSimulator::writeSbs(std::string& out) const {
+    // Date and time fields count from midnight of an arbitrary fixed day
+    int64_t ms = static_cast<int64_t>(m_timeS * 1000.0) % (24 * 3600 * 1000);
+    char stamp[40];
+    std::snprintf(stamp, sizeof(stamp), "2000/01/01,%02d:%02d:%02d.%03d",
+                  static_cast<int>(ms / 3600000), static_cast<int>(ms / 60000 % 60),
+                  static_cast<int>(ms / 1000 % 60), static_cast<int>(ms % 1000));
+
+    // Lines are assembled by hand; snprintf would dominate at 100k+ aircraft
+    char line[256];
+    for (const Target& t : m_targets) {
+        char header[64];
+        char* h = putHex6(put(header, ",1,1,"), t.icao);
+        h = put(put(put(put(h, ",1,"), stamp), ","), stamp);
+        *h = '\0';
+
+        if (t.steps % CALLSIGN_PERIOD == 0 || t.steps == 1) {
+            char* p = put(put(put(put(line, "MSG,1"), header), ","), t.callsign);
+            p = put(p, ",,,,,,,,0,0,0,0\n");
+            out.append(line, p - line);
+        }
+
+        char* p = put(put(put(line, "MSG,3"), header), ",,");
+        p = putInt(p, std::lround(GeoUtils::metersToFeet(t.altitude)));
+        p = putFixed(put(p, ",,,"), t.lat, 5);
+        p = putFixed(put(p, ","), t.lon, 5);
+        p = put(p, ",,,0,0,0,0\n");
+        out.append(line, p - line);
+
+        p = put(put(put(line, "MSG,4"), header), ",,,");
+        p = putFixed(p, GeoUtils::metersPerSecondToKnots(t.speed), 1);
+        p = putFixed(put(p, ","), t.heading, 1);
+        p = putInt(put(p, ",,,"), std::lround(GeoUtils::metersToFeet(t.verticalRate) * 60.0));
+        p = put(p, ",,0,0,0,0\n");
+        out.append(line, p - line);
+    }
+}
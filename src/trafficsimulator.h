@@ -0,0 +1,124 @@
+#ifndef TRAFFICSIMULATOR_H
+#define TRAFFICSIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Seeded air traffic around a point, for load tests and demos
+ *
+ * A fixed population of aircraft fly great circles joined by standard-rate
+ * turns, and climb or descend between flight levels, with speed following
+ * altitude. Aircraft that fly out of the area leave and are replaced by
+ * arrivals at its edge heading inwards. Churn additionally sends a share of
+ * the fleet down to land, each replaced by a departure climbing out from
+ * inside the area.
+ *
+ * The same seed, area and sequence of steps produce the same traffic on
+ * every build: the random generator and its distributions are implemented
+ * here rather than taken from <random>, whose distributions are not portable.
+ * Addresses come from the unallocated block at 0xF00000 and are handed out
+ * in sequence, so an address is not reused while its aircraft can still be
+ * in a receiver's table.
+ */
+class TrafficSimulator {
+public:
+    static constexpr uint32_t ADDRESS_BASE = 0xF00000;
+    static constexpr uint32_t ADDRESS_COUNT = 0x100000;
+    static constexpr int MAX_AIRCRAFT = 262144;
+
+    struct Config {
+        uint64_t seed = 1;
+        int aircraft = 8;               // Population kept in the area
+        double churnPerHour = 0.5;      // Share of the fleet that lands per hour
+    };
+
+    enum Phase : uint8_t {
+        CRUISE,
+        CLIMB,
+        DESCENT,
+        LANDING     // Descending to the ground, then gone
+    };
+
+    struct Target {
+        uint32_t icao;
+        char callsign[9];
+        double lat;             // degrees
+        double lon;             // degrees
+        double altitude;        // meters
+        double speed;           // m/s
+        double heading;         // degrees, current great-circle track
+        double verticalRate;    // m/s
+
+        // Steering
+        Phase phase;
+        double targetAltitude;  // meters
+        double turnRemaining;   // degrees still to turn, positive = right
+        double nextManeuverS;   // seconds until the next course or level change
+        uint32_t steps;         // Steps since the aircraft appeared
+    };
+
+    TrafficSimulator();
+    explicit TrafficSimulator(const Config& config);
+
+    // Restart from the seed with a fresh fleet in the given area
+    void reset(double lat, double lon, double radius);
+
+    /**
+     * Move the area without reseeding
+     *
+     * The old fleet departs (see departed()) and a new one is spawned.
+     */
+    void setArea(double lat, double lon, double radius);
+
+    const Config& config() const { return m_config; }
+    void setConfig(const Config& config) { m_config = config; }
+
+    // Advance every aircraft by dt seconds
+    void step(double dtSeconds);
+
+    const std::vector<Target>& targets() const { return m_targets; }
+    size_t size() const { return m_targets.size(); }
+    double timeSeconds() const { return m_timeS; }
+
+    // Addresses that left, landed or were replaced, until clearDeparted()
+    const std::vector<uint32_t>& departed() const { return m_departed; }
+    void clearDeparted() { m_departed.clear(); }
+
+    /**
+     * Append the current state as SBS-1 lines, as dump1090 writes to port 30003
+     *
+     * Every aircraft gets an airborne position (MSG,3) and a velocity (MSG,4);
+     * the identification (MSG,1) follows when it appears and every 16 steps.
+     */
+    void writeSbs(std::string& out) const;
+
+private:
+    Config m_config;
+    uint64_t m_rng;
+    uint32_t m_nextAddress;
+    double m_timeS;
+
+    double m_centerLat;     // degrees
+    double m_centerLon;
+    double m_radius;        // meters
+
+    std::vector<Target> m_targets;
+    std::vector<uint32_t> m_departed;
+
+    uint64_t next();
+    double uniform();                   // [0, 1)
+    double uniform(double lo, double hi);
+
+    double flightLevel();
+    void spawnFleet();
+    void spawnInside(double maxDistance, double altitude);
+    void spawnAtEdge();
+    void addTarget(double lat, double lon, double heading, double altitude, double targetAltitude);
+    void maneuver(Target& t);
+    bool move(Target& t, double dt);    // false once the aircraft is gone
+};
+
+#endif // TRAFFICSIMULATOR_H